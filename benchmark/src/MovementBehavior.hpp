@@ -1,7 +1,10 @@
 #pragma once
+#include "ecs/component/ComponentStorageTraits.hpp"
 
 struct MovementBehavior
 {
 	float velocityX;
 	float velocityY;
 };
+
+ECS_COMPONENT_STORAGE(MovementBehavior, ecs::DenseComponentCollection)
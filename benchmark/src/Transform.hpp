@@ -1,4 +1,5 @@
 #pragma once
+#include "ecs/component/ComponentStorageTraits.hpp"
 
 struct Transform
 {
@@ -7,3 +8,5 @@ struct Transform
 	float rotation;
 	float scale;
 };
+
+ECS_COMPONENT_STORAGE(Transform, ecs::DenseComponentCollection)
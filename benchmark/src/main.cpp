@@ -1,4 +1,7 @@
 #include "App.hpp"
+#include "micro/MicroBenchmark.hpp"
+
+#include <cstring>
 
 #ifdef OS_WINDOWS
 #include <Windows.h>
@@ -6,8 +9,21 @@
 
 #ifdef OS_WINDOWS
 int CALLBACK WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow)
-#endif
 {
+	const bool runMicroBenchmarks = nullptr != std::strstr(lpCmdLine, micro::k_microBenchmarksArg);
+#else
+int main(int argc, char* argv[])
+{
+	const bool runMicroBenchmarks = argc > 1 && 0 == std::strcmp(argv[1], micro::k_microBenchmarksArg);
+#endif
+
+	// Micro benchmarks measure isolated ECS primitives and don't need rendering
+	if (runMicroBenchmarks)
+	{
+		micro::RunAllMicroBenchmarks();
+		return 0;
+	}
+
 	App app;
 
 	if (!app.Init())
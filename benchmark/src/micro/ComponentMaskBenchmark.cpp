@@ -0,0 +1,104 @@
+#include "MicroBenchmark.hpp"
+#include "ecs/detail/ComponentMask.hpp"
+
+#include <bitset>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const int k_masksCount = 20000;
+const int k_matchRepeats = 50;
+const int k_bitsPerMask = 12;
+const int k_queryBitsCount = 3;
+
+// Fills entity masks with random bits of the first types (content registers most used types first) and the query
+template <typename MaskT>
+void FillMasks(std::vector<MaskT>& masks, MaskT& query, const std::size_t usedTypesCount)
+{
+	std::mt19937 random(42U);
+	std::uniform_int_distribution<std::size_t> typeDistribution(0U, usedTypesCount - 1U);
+
+	masks.resize(k_masksCount);
+	for (MaskT& mask : masks)
+	{
+		for (int i = 0; i < k_bitsPerMask; ++i)
+		{
+			mask.set(typeDistribution(random));
+		}
+	}
+
+	for (int i = 0; i < k_queryBitsCount; ++i)
+	{
+		query.set(typeDistribution(random) % 16U);
+	}
+}
+
+template <std::size_t BitsCount>
+void RunBitsetCase(const std::size_t usedTypesCount)
+{
+	using MaskT = std::bitset<BitsCount>;
+	std::vector<MaskT> masks;
+	MaskT query;
+	FillMasks(masks, query, usedTypesCount);
+
+	long long matches = 0;
+	micro::Stopwatch stopwatch;
+	for (int repeat = 0; repeat < k_matchRepeats; ++repeat)
+	{
+		for (const MaskT& mask : masks)
+		{
+			matches += ((mask & query) == query) ? 1 : 0;
+		}
+	}
+
+	micro::ReportResult("Mask matching", "std::bitset<" + std::to_string(BitsCount) + ">", stopwatch.GetElapsedNanoseconds() / (double(k_masksCount) * k_matchRepeats));
+	micro::ConsumeValue(matches);
+}
+
+template <std::size_t BitsCount>
+void RunComponentMaskCase(const std::size_t usedTypesCount)
+{
+	using MaskT = ecs::detail::ComponentMask<BitsCount>;
+	std::vector<MaskT> masks;
+	MaskT query;
+	FillMasks(masks, query, usedTypesCount);
+
+	long long matches = 0;
+	micro::Stopwatch stopwatch;
+	for (int repeat = 0; repeat < k_matchRepeats; ++repeat)
+	{
+		for (const MaskT& mask : masks)
+		{
+			matches += mask.Contains(query) ? 1 : 0;
+		}
+	}
+
+	micro::ReportResult("Mask matching", "ComponentMask<" + std::to_string(BitsCount) + ">::Contains", stopwatch.GetElapsedNanoseconds() / (double(k_masksCount) * k_matchRepeats));
+	micro::ConsumeValue(matches);
+}
+
+template <std::size_t BitsCount>
+void RunWidthCases()
+{
+	// Types are spread over the first 128 bits, so wider masks measure the cost of their empty words
+	RunBitsetCase<BitsCount>(128U);
+	RunComponentMaskCase<BitsCount>(128U);
+}
+
+}
+
+namespace micro
+{
+
+void RunComponentMaskBenchmark()
+{
+	RunWidthCases<128U>();
+	RunWidthCases<256U>();
+	RunWidthCases<1024U>();
+	RunWidthCases<4096U>();
+}
+
+}
@@ -0,0 +1,102 @@
+#include "MicroBenchmark.hpp"
+#include "ecs/Manager.hpp"
+
+#include <vector>
+
+namespace
+{
+
+struct PagedHealth { int value; };
+struct DenseHealth { int value; };
+struct ArchetypeHealth { int value; };
+
+}
+
+ECS_COMPONENT_STORAGE(DenseHealth, ecs::DenseComponentCollection)
+ECS_COMPONENT_STORAGE(ArchetypeHealth, ecs::ArchetypeComponentCollection)
+
+namespace
+{
+
+const int k_handlesCount = 100000;
+const int k_dereferenceRepeats = 50;
+
+// Dereferences every handle, reading component field
+template <typename ComponentT>
+void RunHandlesCase(ecs::Manager& manager, const std::string& caseName)
+{
+	std::vector<ecs::Entity> entities;
+	std::vector<ecs::TComponentPtr<ComponentT>> handles;
+	entities.reserve(k_handlesCount);
+	handles.reserve(k_handlesCount);
+
+	for (int i = 0; i < k_handlesCount; ++i)
+	{
+		// Components are attached, so archetype components leave staging storage
+		ecs::Entity entity = manager.CreateEntity();
+		handles.push_back(manager.CreateComponent<ComponentT>(i));
+		entity.AddComponent(handles.back());
+		entities.push_back(entity);
+	}
+
+	long long sum = 0;
+	micro::Stopwatch stopwatch;
+	for (int repeat = 0; repeat < k_dereferenceRepeats; ++repeat)
+	{
+		for (const auto& handle : handles)
+		{
+			sum += handle->value;
+		}
+	}
+
+	micro::ReportResult("Handle dereference", caseName, stopwatch.GetElapsedNanoseconds() / (double(k_handlesCount) * k_dereferenceRepeats));
+	micro::ConsumeValue(sum);
+}
+
+void RunRawPointersCase()
+{
+	std::vector<int> values(k_handlesCount, 1);
+	std::vector<const int*> pointers;
+	pointers.reserve(k_handlesCount);
+	for (const int& value : values)
+	{
+		pointers.push_back(&value);
+	}
+
+	long long sum = 0;
+	micro::Stopwatch stopwatch;
+	for (int repeat = 0; repeat < k_dereferenceRepeats; ++repeat)
+	{
+		for (const int* pointer : pointers)
+		{
+			sum += *pointer;
+		}
+	}
+
+	micro::ReportResult("Handle dereference", "raw pointers (baseline)", stopwatch.GetElapsedNanoseconds() / (double(k_handlesCount) * k_dereferenceRepeats));
+	micro::ConsumeValue(sum);
+}
+
+}
+
+namespace micro
+{
+
+void RunHandleDereferenceBenchmark()
+{
+	ecs::Manager::InitECSManager();
+	ecs::Manager& manager = *ecs::Manager::Get();
+	manager.RegisterComponentType<PagedHealth>("PagedHealth");
+	manager.RegisterComponentType<DenseHealth>("DenseHealth");
+	manager.RegisterComponentType<ArchetypeHealth>("ArchetypeHealth");
+	manager.Init();
+
+	RunRawPointersCase();
+	RunHandlesCase<PagedHealth>(manager, "paged pool (cached address)");
+	RunHandlesCase<DenseHealth>(manager, "dense array (cached address)");
+	RunHandlesCase<ArchetypeHealth>(manager, "archetype (resolved by collection)");
+
+	ecs::Manager::ShutdownECSManager();
+}
+
+}
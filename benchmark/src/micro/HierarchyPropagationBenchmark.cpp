@@ -0,0 +1,189 @@
+#include "MicroBenchmark.hpp"
+#include "ecs/Manager.hpp"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+const int k_nodesCount = 200000;
+const int k_rootsCount = 100;
+const int k_propagationRepeats = 20;
+// Levels smaller than this are processed on the calling thread
+const std::size_t k_minParallelLevelSize = 4096U;
+
+struct Position
+{
+	float x = 0.0f;
+	float y = 0.0f;
+	float z = 0.0f;
+};
+
+// Local and world positions, indexed by entity location
+struct Transforms
+{
+	std::vector<Position> local;
+	std::vector<Position> world;
+};
+
+void UpdateWorld(Transforms& transforms, const ecs::EntityId entityId, const ecs::EntityId parentId)
+{
+	const Position& local = transforms.local[ecs::detail::GetEntityIndex(entityId)];
+	Position& world = transforms.world[ecs::detail::GetEntityIndex(entityId)];
+	if (parentId == ecs::Entity::GetInvalidId())
+	{
+		world = local;
+		return;
+	}
+
+	const Position& parentWorld = transforms.world[ecs::detail::GetEntityIndex(parentId)];
+	world.x = parentWorld.x + local.x;
+	world.y = parentWorld.y + local.y;
+	world.z = parentWorld.z + local.z;
+}
+
+long long GetChecksum(const Transforms& transforms)
+{
+	double sum = 0.0;
+	for (const Position& world : transforms.world)
+	{
+		sum += world.x + world.y + world.z;
+	}
+
+	return static_cast<long long>(sum);
+}
+
+void ReportCase(const std::string& caseName, const micro::Stopwatch& stopwatch, const Transforms& transforms)
+{
+	micro::ReportResult("Hierarchy propagation", caseName, stopwatch.GetElapsedNanoseconds() / (double(k_nodesCount) * k_propagationRepeats));
+	micro::ConsumeValue(GetChecksum(transforms));
+}
+
+// Parent before child walk of every root subtree
+void RunTreeWalkCase(ecs::Manager& manager, const std::vector<ecs::Entity>& roots, Transforms& transforms)
+{
+	micro::Stopwatch stopwatch;
+	for (int repeat = 0; repeat < k_propagationRepeats; ++repeat)
+	{
+		for (const ecs::Entity& root : roots)
+		{
+			manager.ForEachInHierarchy(root, [&transforms](ecs::Entity& entity)
+			{
+				UpdateWorld(transforms, entity.GetId(), entity.GetParent().GetId());
+			});
+		}
+	}
+
+	ReportCase("tree walk", stopwatch, transforms);
+}
+
+void RunLevelsCase(ecs::Manager& manager, Transforms& transforms)
+{
+	micro::Stopwatch stopwatch;
+	for (int repeat = 0; repeat < k_propagationRepeats; ++repeat)
+	{
+		manager.ForEachHierarchyLevel([&transforms](uint16_t, std::size_t count, const ecs::EntityId* entities, const ecs::EntityId* parents)
+		{
+			for (std::size_t i = 0U; i < count; ++i)
+			{
+				UpdateWorld(transforms, entities[i], parents[i]);
+			}
+		});
+	}
+
+	ReportCase("levels", stopwatch, transforms);
+}
+
+// Every large level is split between worker threads, which are joined before the next level
+void RunParallelLevelsCase(ecs::Manager& manager, Transforms& transforms)
+{
+	const std::size_t threadsCount = std::max(1U, std::thread::hardware_concurrency());
+	std::vector<std::thread> workers;
+	workers.reserve(threadsCount);
+
+	micro::Stopwatch stopwatch;
+	for (int repeat = 0; repeat < k_propagationRepeats; ++repeat)
+	{
+		manager.ForEachHierarchyLevel([&](uint16_t, std::size_t count, const ecs::EntityId* entities, const ecs::EntityId* parents)
+		{
+			auto updateRange = [&transforms, entities, parents](const std::size_t begin, const std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					UpdateWorld(transforms, entities[i], parents[i]);
+				}
+			};
+
+			if (threadsCount == 1U || count < k_minParallelLevelSize)
+			{
+				updateRange(0U, count);
+				return;
+			}
+
+			const std::size_t rangeSize = (count + threadsCount - 1U) / threadsCount;
+			for (std::size_t begin = rangeSize; begin < count; begin += rangeSize)
+			{
+				workers.emplace_back(updateRange, begin, std::min(begin + rangeSize, count));
+			}
+
+			updateRange(0U, rangeSize);
+			for (std::thread& worker : workers)
+			{
+				worker.join();
+			}
+			workers.clear();
+		});
+	}
+
+	ReportCase("levels, " + std::to_string(threadsCount) + " threads", stopwatch, transforms);
+}
+
+}
+
+namespace micro
+{
+
+void RunHierarchyPropagationBenchmark()
+{
+	ecs::Manager::InitECSManager();
+	ecs::Manager& manager = *ecs::Manager::Get();
+	manager.Init();
+
+	// Random forest: every node is attached to one of the previously created nodes
+	std::mt19937 random(42U);
+	std::vector<ecs::Entity> nodes;
+	nodes.reserve(k_nodesCount);
+	for (int i = 0; i < k_nodesCount; ++i)
+	{
+		nodes.push_back(manager.CreateEntity());
+		if (i >= k_rootsCount)
+		{
+			// Parents are picked from the recent nodes, so the forest is deep
+			const int parentIndex = std::max(0, i - 1 - int(random() % 64U));
+			nodes[parentIndex].AddChild(nodes[i]);
+		}
+	}
+
+	Transforms transforms;
+	transforms.local.resize(k_nodesCount);
+	transforms.world.resize(k_nodesCount);
+	for (Position& local : transforms.local)
+	{
+		local.x = float(random() % 16U);
+		local.y = float(random() % 16U);
+		local.z = float(random() % 16U);
+	}
+
+	const std::vector<ecs::Entity> roots(nodes.begin(), nodes.begin() + k_rootsCount);
+	RunTreeWalkCase(manager, roots, transforms);
+	RunLevelsCase(manager, transforms);
+	RunParallelLevelsCase(manager, transforms);
+
+	nodes.clear();
+	ecs::Manager::ShutdownECSManager();
+}
+
+}
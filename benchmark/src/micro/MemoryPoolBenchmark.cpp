@@ -0,0 +1,72 @@
+#include "MicroBenchmark.hpp"
+#include "ecs/storage/MemoryPool.hpp"
+
+namespace
+{
+
+// Short lived, trivially copyable entity-like record
+struct ChurnPayload
+{
+	long long id = 0;
+	float values[12] = {};
+};
+
+const std::size_t k_poolItemsCount = 64U * 1024U;
+const std::size_t k_churnBatchSize = 1024U;
+const int k_churnRepeats = 200;
+
+void FillPool(ecs::detail::MemoryPool<ChurnPayload>& pool, const std::size_t count)
+{
+	while (pool.GetItemsCount() < count)
+	{
+		pool.CreateItem().second->id = static_cast<long long>(pool.GetItemsCount());
+	}
+}
+
+void RunSingleRemovalCase()
+{
+	ecs::detail::MemoryPool<ChurnPayload> pool(1024U);
+	FillPool(pool, k_poolItemsCount);
+
+	micro::Stopwatch stopwatch;
+	for (int repeat = 0; repeat < k_churnRepeats; ++repeat)
+	{
+		for (std::size_t i = 0U; i < k_churnBatchSize; ++i)
+		{
+			pool.DestroyItem(k_churnBatchSize);
+		}
+		FillPool(pool, k_poolItemsCount);
+	}
+
+	micro::ConsumeValue(pool[k_churnBatchSize]->id);
+	micro::ReportResult("MemoryPool churn", "single item removal", stopwatch.GetElapsedNanoseconds() / (double(k_churnBatchSize) * k_churnRepeats));
+}
+
+void RunBatchRemovalCase()
+{
+	ecs::detail::MemoryPool<ChurnPayload> pool(1024U);
+	FillPool(pool, k_poolItemsCount);
+
+	micro::Stopwatch stopwatch;
+	for (int repeat = 0; repeat < k_churnRepeats; ++repeat)
+	{
+		pool.DestroyItems(k_churnBatchSize, k_churnBatchSize);
+		FillPool(pool, k_poolItemsCount);
+	}
+
+	micro::ConsumeValue(pool[k_churnBatchSize]->id);
+	micro::ReportResult("MemoryPool churn", "batch removal", stopwatch.GetElapsedNanoseconds() / (double(k_churnBatchSize) * k_churnRepeats));
+}
+
+}
+
+namespace micro
+{
+
+void RunMemoryPoolChurnBenchmark()
+{
+	RunSingleRemovalCase();
+	RunBatchRemovalCase();
+}
+
+}
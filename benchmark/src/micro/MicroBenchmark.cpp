@@ -0,0 +1,45 @@
+#include "MicroBenchmark.hpp"
+
+#include <cstdio>
+
+#ifdef OS_WINDOWS
+#include <Windows.h>
+#endif
+
+namespace
+{
+volatile long long g_consumedValue = 0;
+}
+
+namespace micro
+{
+
+void ReportResult(const std::string& benchmarkName, const std::string& caseName, const double nanosecondsPerItem)
+{
+	char buffer[256];
+	std::snprintf(buffer, sizeof(buffer), "[%s] %-40s %10.3f ns/item\n", benchmarkName.c_str(), caseName.c_str(), nanosecondsPerItem);
+
+	std::fputs(buffer, stdout);
+#ifdef OS_WINDOWS
+	OutputDebugStringA(buffer);
+#endif
+}
+
+void ConsumeValue(const long long value)
+{
+	g_consumedValue = g_consumedValue + value;
+}
+
+void RunAllMicroBenchmarks()
+{
+	RunObjectPoolIterationBenchmark();
+	RunMovementUpdateBenchmark();
+	RunMemoryPoolChurnBenchmark();
+	RunWorldAllocatorBenchmark();
+	RunHandleDereferenceBenchmark();
+	RunComponentMaskBenchmark();
+	RunHierarchyPropagationBenchmark();
+	RunPrefabInstantiateBenchmark();
+}
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <chrono>
+#include <string>
+
+namespace micro
+{
+
+// Command line argument, which switches benchmark application to the micro benchmarks mode
+constexpr const char* k_microBenchmarksArg = "--micro";
+
+/*
+* @brief Measures wall time of the code block, placed between construction and GetElapsedNanoseconds call
+*/
+class Stopwatch
+{
+public:
+	Stopwatch()
+		: m_start(std::chrono::high_resolution_clock::now())
+	{}
+
+	double GetElapsedNanoseconds() const
+	{
+		auto now = std::chrono::high_resolution_clock::now();
+		return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_start).count());
+	}
+
+private:
+	std::chrono::high_resolution_clock::time_point m_start;
+};
+
+// Prints single benchmark case result line
+void ReportResult(const std::string& benchmarkName, const std::string& caseName, const double nanosecondsPerItem);
+
+// Prevents compiler from optimizing out benchmarked computations
+void ConsumeValue(const long long value);
+
+void RunAllMicroBenchmarks();
+
+void RunObjectPoolIterationBenchmark();
+void RunMovementUpdateBenchmark();
+void RunMemoryPoolChurnBenchmark();
+void RunWorldAllocatorBenchmark();
+void RunHandleDereferenceBenchmark();
+void RunComponentMaskBenchmark();
+void RunHierarchyPropagationBenchmark();
+void RunPrefabInstantiateBenchmark();
+
+}
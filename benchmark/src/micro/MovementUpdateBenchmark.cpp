@@ -0,0 +1,169 @@
+#include "MicroBenchmark.hpp"
+#include "ecs/Manager.hpp"
+
+#include <vector>
+
+namespace
+{
+
+// Same data layout in four storage modes: paged pool (default), dense array of structs, struct of arrays, and archetype chunks
+struct PagedPosition { float x; float y; };
+struct PagedVelocity { float x; float y; };
+struct DensePosition { float x; float y; };
+struct DenseVelocity { float x; float y; };
+struct SoAPosition { float x; float y; };
+struct SoAVelocity { float x; float y; };
+struct ArchetypePosition { float x; float y; };
+struct ArchetypeVelocity { float x; float y; };
+
+}
+
+ECS_COMPONENT_STORAGE(DensePosition, ecs::DenseComponentCollection)
+ECS_COMPONENT_STORAGE(DenseVelocity, ecs::DenseComponentCollection)
+ECS_SOA_COMPONENT(SoAPosition, &SoAPosition::x, &SoAPosition::y)
+ECS_SOA_COMPONENT(SoAVelocity, &SoAVelocity::x, &SoAVelocity::y)
+ECS_COMPONENT_STORAGE(ArchetypePosition, ecs::ArchetypeComponentCollection)
+ECS_COMPONENT_STORAGE(ArchetypeVelocity, ecs::ArchetypeComponentCollection)
+
+namespace
+{
+
+const int k_entitiesCount = 100000;
+const int k_updateRepeats = 50;
+const float k_timeDelta = 0.016f;
+
+template <typename PositionT, typename VelocityT>
+void CreateEntities(ecs::Manager& manager, std::vector<ecs::Entity>& outEntities)
+{
+	for (int i = 0; i < k_entitiesCount; ++i)
+	{
+		ecs::Entity entity = manager.CreateEntity();
+		entity.AddComponent(manager.CreateComponent<PositionT>(static_cast<float>(i), 0.f));
+		entity.AddComponent(manager.CreateComponent<VelocityT>(1.f, 2.f));
+		outEntities.push_back(entity);
+	}
+}
+
+void RunPagedCase(ecs::Manager& manager)
+{
+	auto& velocities = *manager.GetComponentCollection<PagedVelocity>();
+
+	micro::Stopwatch stopwatch;
+	for (int repeat = 0; repeat < k_updateRepeats; ++repeat)
+	{
+		for (auto velocity : velocities)
+		{
+			auto position = velocity.GetSibling<PagedPosition>();
+			position->x += velocity->x * k_timeDelta;
+			position->y += velocity->y * k_timeDelta;
+		}
+	}
+
+	micro::ReportResult("Movement update", "paged pools, sibling lookup", stopwatch.GetElapsedNanoseconds() / (double(k_entitiesCount) * k_updateRepeats));
+}
+
+void RunDenseCase(ecs::Manager& manager)
+{
+	auto& positions = *manager.GetComponentCollection<DensePosition>();
+	auto& velocities = *manager.GetComponentCollection<DenseVelocity>();
+
+	micro::Stopwatch stopwatch;
+	for (int repeat = 0; repeat < k_updateRepeats; ++repeat)
+	{
+		const std::size_t count = ecs::AlignCollections(velocities, positions);
+		DensePosition* position = positions.GetComponentsData();
+		const DenseVelocity* velocity = velocities.GetComponentsData();
+
+		for (std::size_t i = 0U; i < count; ++i)
+		{
+			position[i].x += velocity[i].x * k_timeDelta;
+			position[i].y += velocity[i].y * k_timeDelta;
+		}
+	}
+
+	micro::ReportResult("Movement update", "dense arrays of structs", stopwatch.GetElapsedNanoseconds() / (double(k_entitiesCount) * k_updateRepeats));
+}
+
+void RunSoACase(ecs::Manager& manager)
+{
+	auto& positions = *manager.GetComponentCollection<SoAPosition>();
+	auto& velocities = *manager.GetComponentCollection<SoAVelocity>();
+
+	micro::Stopwatch stopwatch;
+	for (int repeat = 0; repeat < k_updateRepeats; ++repeat)
+	{
+		const std::size_t count = ecs::AlignCollections(velocities, positions);
+		float* positionX = positions.GetColumn(&SoAPosition::x).data;
+		float* positionY = positions.GetColumn(&SoAPosition::y).data;
+		const float* velocityX = velocities.GetColumn(&SoAVelocity::x).data;
+		const float* velocityY = velocities.GetColumn(&SoAVelocity::y).data;
+
+		for (std::size_t i = 0U; i < count; ++i)
+		{
+			positionX[i] += velocityX[i] * k_timeDelta;
+		}
+
+		for (std::size_t i = 0U; i < count; ++i)
+		{
+			positionY[i] += velocityY[i] * k_timeDelta;
+		}
+	}
+
+	micro::ReportResult("Movement update", "struct of arrays columns", stopwatch.GetElapsedNanoseconds() / (double(k_entitiesCount) * k_updateRepeats));
+}
+
+void RunArchetypeCase(ecs::Manager& manager)
+{
+	micro::Stopwatch stopwatch;
+	for (int repeat = 0; repeat < k_updateRepeats; ++repeat)
+	{
+		manager.ForEachArchetypeChunk<ArchetypePosition, ArchetypeVelocity>([](std::size_t count, const ecs::EntityId*, ArchetypePosition* position, ArchetypeVelocity* velocity)
+		{
+			for (std::size_t i = 0U; i < count; ++i)
+			{
+				position[i].x += velocity[i].x * k_timeDelta;
+				position[i].y += velocity[i].y * k_timeDelta;
+			}
+		});
+	}
+
+	micro::ReportResult("Movement update", "archetype chunks", stopwatch.GetElapsedNanoseconds() / (double(k_entitiesCount) * k_updateRepeats));
+}
+
+}
+
+namespace micro
+{
+
+void RunMovementUpdateBenchmark()
+{
+	ecs::Manager::InitECSManager();
+	ecs::Manager& manager = *ecs::Manager::Get();
+
+	manager.RegisterComponentType<PagedPosition>("PagedPosition");
+	manager.RegisterComponentType<PagedVelocity>("PagedVelocity");
+	manager.RegisterComponentType<DensePosition>("DensePosition");
+	manager.RegisterComponentType<DenseVelocity>("DenseVelocity");
+	manager.RegisterComponentType<SoAPosition>("SoAPosition");
+	manager.RegisterComponentType<SoAVelocity>("SoAVelocity");
+	manager.RegisterComponentType<ArchetypePosition>("ArchetypePosition");
+	manager.RegisterComponentType<ArchetypeVelocity>("ArchetypeVelocity");
+	manager.Init();
+
+	{
+		std::vector<ecs::Entity> entities;
+		CreateEntities<PagedPosition, PagedVelocity>(manager, entities);
+		CreateEntities<DensePosition, DenseVelocity>(manager, entities);
+		CreateEntities<SoAPosition, SoAVelocity>(manager, entities);
+		CreateEntities<ArchetypePosition, ArchetypeVelocity>(manager, entities);
+
+		RunPagedCase(manager);
+		RunDenseCase(manager);
+		RunSoACase(manager);
+		RunArchetypeCase(manager);
+	}
+
+	ecs::Manager::ShutdownECSManager();
+}
+
+}
@@ -0,0 +1,85 @@
+#include "MicroBenchmark.hpp"
+#include "ecs/storage/ObjectPool.hpp"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+// Payload size matches typical small component with its control block
+struct PoolPayload
+{
+	long long value = 0;
+	int padding[6] = {};
+
+	PoolPayload() = default;
+	PoolPayload(long long inValue)
+		: value(inValue)
+	{}
+};
+
+const std::size_t k_poolSlotsCount = 256U * 1024U;
+const int k_iterationRepeats = 20;
+
+void RunIterationCase(const double occupancy)
+{
+	ecs::ObjectPool<PoolPayload> pool;
+	for (std::size_t i = 0U; i < k_poolSlotsCount; ++i)
+	{
+		pool.Emplace(static_cast<long long>(i));
+	}
+
+	// Remove random items to get requested occupancy
+	std::mt19937 randomEngine(42U);
+	std::uniform_real_distribution<double> distribution(0.0, 1.0);
+	std::size_t aliveCount = 0U;
+	for (std::size_t i = 0U; i < k_poolSlotsCount; ++i)
+	{
+		if (distribution(randomEngine) >= occupancy)
+		{
+			pool.RemoveAt(i);
+		}
+		else
+		{
+			++aliveCount;
+		}
+	}
+
+	micro::Stopwatch stopwatch;
+	long long sum = 0;
+	for (int repeat = 0; repeat < k_iterationRepeats; ++repeat)
+	{
+		for (PoolPayload& payload : pool)
+		{
+			sum += payload.value;
+		}
+	}
+	const double elapsed = stopwatch.GetElapsedNanoseconds();
+	micro::ConsumeValue(sum);
+
+	const double totalSlots = static_cast<double>(k_poolSlotsCount) * k_iterationRepeats;
+	const double totalItems = static_cast<double>(aliveCount > 0U ? aliveCount : 1U) * k_iterationRepeats;
+	char caseName[64];
+	std::snprintf(caseName, sizeof(caseName), "occupancy %.1f%%, per alive item", occupancy * 100.0);
+	micro::ReportResult("ObjectPool iteration", caseName, elapsed / totalItems);
+	std::snprintf(caseName, sizeof(caseName), "occupancy %.1f%%, per pool slot", occupancy * 100.0);
+	micro::ReportResult("ObjectPool iteration", caseName, elapsed / totalSlots);
+}
+
+}
+
+namespace micro
+{
+
+void RunObjectPoolIterationBenchmark()
+{
+	const double k_occupancies[] = { 0.001, 0.01, 0.1, 0.5, 0.9, 1.0 };
+	for (double occupancy : k_occupancies)
+	{
+		RunIterationCase(occupancy);
+	}
+}
+
+}
@@ -0,0 +1,102 @@
+#include "MicroBenchmark.hpp"
+#include "ecs/Manager.hpp"
+
+#include <vector>
+
+namespace
+{
+
+struct Bullet { float x; float y; };
+struct BulletVelocity { float x; float y; };
+struct BulletDamage { int value; };
+struct BulletTrail { float length; };
+
+const int k_instancesCount = 10000;
+const int k_instantiateRepeats = 10;
+
+// Bullet entity with a trail child, which is the spawned template in both cases
+ecs::Entity CreateTemplate(ecs::Manager& manager)
+{
+	ecs::Entity bullet = manager.CreateEntity();
+	bullet.AddComponent(manager.CreateComponent<Bullet>(1.0f, 2.0f));
+	bullet.AddComponent(manager.CreateComponent<BulletVelocity>(0.0f, 10.0f));
+	bullet.AddComponent(manager.CreateComponent<BulletDamage>(5));
+
+	ecs::Entity trail = manager.CreateEntity();
+	trail.AddComponent(manager.CreateComponent<BulletTrail>(3.0f));
+	bullet.AddChild(trail);
+
+	return bullet;
+}
+
+void RunCloneCase(const ecs::Entity& bullet)
+{
+	std::vector<ecs::Entity> instances;
+	instances.reserve(k_instancesCount);
+
+	double elapsed = 0.0;
+	for (int repeat = 0; repeat < k_instantiateRepeats; ++repeat)
+	{
+		micro::Stopwatch stopwatch;
+		for (int i = 0; i < k_instancesCount; ++i)
+		{
+			instances.push_back(bullet.Clone());
+		}
+		elapsed += stopwatch.GetElapsedNanoseconds();
+
+		micro::ConsumeValue(static_cast<long long>(instances.size()));
+		instances.clear();
+	}
+
+	micro::ReportResult("Prefab instantiate", "Entity::Clone per instance", elapsed / (double(k_instancesCount) * k_instantiateRepeats));
+}
+
+void RunInstantiateCase(ecs::Manager& manager, const ecs::Entity& bullet)
+{
+	const ecs::Prefab prefab(bullet);
+	std::vector<ecs::Entity> instances(k_instancesCount);
+
+	double elapsed = 0.0;
+	for (int repeat = 0; repeat < k_instantiateRepeats; ++repeat)
+	{
+		micro::Stopwatch stopwatch;
+		manager.Instantiate(prefab, instances.size(), instances.data());
+		elapsed += stopwatch.GetElapsedNanoseconds();
+
+		micro::ConsumeValue(static_cast<long long>(instances.size()));
+		for (ecs::Entity& instance : instances)
+		{
+			instance.Reset();
+		}
+	}
+
+	micro::ReportResult("Prefab instantiate", "Manager::Instantiate batch", elapsed / (double(k_instancesCount) * k_instantiateRepeats));
+}
+
+}
+
+namespace micro
+{
+
+void RunPrefabInstantiateBenchmark()
+{
+	ecs::Manager::InitECSManager();
+	ecs::Manager& manager = *ecs::Manager::Get();
+	manager.RegisterComponentType<Bullet>("Bullet");
+	manager.RegisterComponentType<BulletVelocity>("BulletVelocity");
+	manager.RegisterComponentType<BulletDamage>("BulletDamage");
+	manager.RegisterComponentType<BulletTrail>("BulletTrail");
+	manager.Init();
+
+	// Movement tuple is tracked, so both cases pay for tuple cache updates
+	manager.RegisterComponentsTupleIterator<Bullet, BulletVelocity>();
+
+	ecs::Entity bullet = CreateTemplate(manager);
+	RunCloneCase(bullet);
+	RunInstantiateCase(manager, bullet);
+
+	bullet.Reset();
+	ecs::Manager::ShutdownECSManager();
+}
+
+}
@@ -0,0 +1,103 @@
+#include "MicroBenchmark.hpp"
+#include "ecs/Manager.hpp"
+
+#include <memory_resource>
+#include <vector>
+
+namespace
+{
+
+struct ChurnTransform { float x; float y; float rotation; };
+struct ChurnHealth { int value; };
+
+const int k_worldsCount = 20;
+const int k_churnRounds = 10;
+const int k_entitiesPerRound = 10000;
+
+// Creates a world on the resource, churns entities with components through it, and destroys the world
+void RunWorld(std::pmr::memory_resource* resource, std::vector<ecs::Entity>& entities)
+{
+	ecs::Manager::InitECSManager(resource);
+	ecs::Manager& manager = *ecs::Manager::Get();
+	manager.RegisterComponentType<ChurnTransform>("ChurnTransform");
+	manager.RegisterComponentType<ChurnHealth>("ChurnHealth");
+	manager.Init();
+
+	for (int round = 0; round < k_churnRounds; ++round)
+	{
+		for (int i = 0; i < k_entitiesPerRound; ++i)
+		{
+			ecs::Entity entity = manager.CreateEntity();
+			entity.AddComponent(manager.CreateComponent<ChurnTransform>(static_cast<float>(i), 0.f, 0.f));
+			entity.AddComponent(manager.CreateComponent<ChurnHealth>(100));
+			entities.push_back(entity);
+		}
+
+		micro::ConsumeValue(entities.back().GetId());
+		entities.clear();
+	}
+
+	ecs::Manager::ShutdownECSManager();
+}
+
+void RunGlobalHeapCase()
+{
+	std::vector<ecs::Entity> entities;
+	entities.reserve(k_entitiesPerRound);
+
+	micro::Stopwatch stopwatch;
+	for (int world = 0; world < k_worldsCount; ++world)
+	{
+		RunWorld(nullptr, entities);
+	}
+
+	micro::ReportResult("World churn", "global heap", stopwatch.GetElapsedNanoseconds() / (double(k_worldsCount) * k_churnRounds * k_entitiesPerRound));
+}
+
+void RunPoolResourceCase()
+{
+	std::vector<ecs::Entity> entities;
+	entities.reserve(k_entitiesPerRound);
+
+	micro::Stopwatch stopwatch;
+	for (int world = 0; world < k_worldsCount; ++world)
+	{
+		// Pool keeps freed blocks of every size class, and returns all the memory to the heap at once
+		std::pmr::unsynchronized_pool_resource resource;
+		RunWorld(&resource, entities);
+	}
+
+	micro::ReportResult("World churn", "unsynchronized pool resource", stopwatch.GetElapsedNanoseconds() / (double(k_worldsCount) * k_churnRounds * k_entitiesPerRound));
+}
+
+void RunMonotonicArenaCase()
+{
+	std::vector<ecs::Entity> entities;
+	entities.reserve(k_entitiesPerRound);
+
+	// Arena buffer is reused by every world, world is freed by releasing the arena
+	std::pmr::monotonic_buffer_resource arena(64U * 1024U * 1024U);
+
+	micro::Stopwatch stopwatch;
+	for (int world = 0; world < k_worldsCount; ++world)
+	{
+		RunWorld(&arena, entities);
+		arena.release();
+	}
+
+	micro::ReportResult("World churn", "monotonic arena", stopwatch.GetElapsedNanoseconds() / (double(k_worldsCount) * k_churnRounds * k_entitiesPerRound));
+}
+
+}
+
+namespace micro
+{
+
+void RunWorldAllocatorBenchmark()
+{
+	RunGlobalHeapCase();
+	RunPoolResourceCase();
+	RunMonotonicArenaCase();
+}
+
+}
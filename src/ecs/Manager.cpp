@@ -6,6 +6,14 @@
 namespace
 {
 ecs::Manager* ManagerInstance = nullptr;
+
+ecs::AllocationPolicy MakeAllocationPolicy(std::pmr::memory_resource* resource)
+{
+	ecs::AllocationPolicy policy;
+	policy.resource = resource;
+
+	return policy;
+}
 }
 
 namespace ecs
@@ -13,8 +21,14 @@ namespace ecs
 
 const std::string k_invalidComponentName = "[UNDEFINED]";
 
-Manager::Manager()
-{}
+Manager::Manager(std::pmr::memory_resource* resource)
+	: m_allocationPolicy(MakeAllocationPolicy(resource))
+	, m_archetypeStorage(GetMemoryResource())
+	, m_entitiesCollection(GetMemoryResource())
+{
+	m_archetypeStorage.SetAllocationPolicy(m_allocationPolicy);
+	SetFrameAllocatorsCount(1U);
+}
 
 System* Manager::GetSystemByTypeIndex(const std::type_index& typeIndex) const
 {
@@ -36,6 +50,13 @@ void Manager::AddSystemToStorage(SystemPtr&& system)
 void Manager::AddSystem(System* system)
 {
 	m_systemsTypeIdMapping.emplace(typeid(*system), system);
+
+	const uint32_t sequenceIndex = detail::GetTypeSequenceIndex(detail::TypeFamily::System, typeid(*system));
+	if (sequenceIndex >= m_systemsBySequence.size())
+	{
+		m_systemsBySequence.resize(sequenceIndex + 1U, nullptr);
+	}
+	m_systemsBySequence[sequenceIndex] = system;
 	m_newSystems.emplace_back(system, m_isUpdatingSystems);
 
 	if (!m_isUpdatingSystems)
@@ -66,6 +87,12 @@ void Manager::DoRemoveSystem(System* system)
 		{
 			m_systemsTypeIdMapping.erase(it);
 		}
+
+		const uint32_t sequenceIndex = detail::GetTypeSequenceIndex(detail::TypeFamily::System, typeid(*system));
+		if (sequenceIndex < m_systemsBySequence.size() && m_systemsBySequence[sequenceIndex] == system)
+		{
+			m_systemsBySequence[sequenceIndex] = nullptr;
+		}
 	}
 	
 	{
@@ -108,6 +135,7 @@ void Manager::Destroy()
 		system->DispatchDestroy();
 	}
 	m_systemsTypeIdMapping.clear();
+	m_systemsBySequence.clear();
 	m_systemsStorage.clear();
 	m_orderedSystems.clear();
 
@@ -117,14 +145,20 @@ void Manager::Destroy()
 	// Destroy components
 	for (auto& storage : m_componentStorages)
 	{
-		storage->Clear();
-		storage.reset();
+		if (storage)
+		{
+			storage->Clear();
+			storage.reset();
+		}
 	}
 	m_componentStorages.clear();
+	m_tagTypesMask.reset();
+	m_archetypeStorage.Clear();
 
 	m_componentTypeIndexes.clear();
 	m_componentNameToIdMapping.clear();
 	m_typeIndexToComponentTypeIdMapping.clear();
+	m_componentTypeIdsBySequence.clear();
 
 	m_componentAttachedDelegate.UnbindAll();
 	m_componentDetachedDelegate.UnbindAll();
@@ -187,6 +221,9 @@ void Manager::Update()
 
 		m_removedSystems.clear();
 	}
+
+	// Temporary data of the update is released at once
+	ResetFrameAllocators();
 }
 
 void Manager::UpdateSystems()
@@ -212,6 +249,97 @@ void Manager::SortOrderedSystemsList()
 	m_systemPrioritiesChanged = false;
 }
 
+void Manager::SetAllocationPolicy(const AllocationPolicy& policy)
+{
+	std::pmr::memory_resource* resource = m_allocationPolicy.resource;
+	m_allocationPolicy = policy;
+	m_allocationPolicy.resource = resource;
+	m_archetypeStorage.SetAllocationPolicy(m_allocationPolicy);
+}
+
+const AllocationPolicy& Manager::GetAllocationPolicy() const
+{
+	return m_allocationPolicy;
+}
+
+std::pmr::memory_resource* Manager::GetMemoryResource() const
+{
+	return detail::GetMemoryResource(m_allocationPolicy);
+}
+
+FrameAllocator& Manager::GetFrameAllocator(const std::size_t threadIndex)
+{
+	assert(threadIndex < m_frameAllocators.size());
+	return *m_frameAllocators[threadIndex];
+}
+
+void Manager::SetFrameAllocatorsCount(const std::size_t threadsCount)
+{
+	assert(!m_isUpdatingSystems && threadsCount > 0U);
+
+	while (m_frameAllocators.size() < threadsCount)
+	{
+		m_frameAllocators.push_back(std::make_unique<FrameAllocator>(FrameAllocator::k_defaultBlockSize, GetMemoryResource()));
+	}
+
+	m_frameAllocators.resize(threadsCount);
+}
+
+std::size_t Manager::GetFrameAllocatorsCount() const
+{
+	return m_frameAllocators.size();
+}
+
+void Manager::ResetFrameAllocators()
+{
+	for (auto& frameAllocator : m_frameAllocators)
+	{
+		frameAllocator->Reset();
+	}
+}
+
+bool Manager::Compact(const std::chrono::nanoseconds timeBudget)
+{
+	assert(!m_isUpdatingSystems);
+
+	const auto startTime = std::chrono::steady_clock::now();
+	const std::size_t stepsCount = m_componentStorages.size() + 1U;
+
+	while (m_compactionStep < stepsCount)
+	{
+		if (m_compactionStep < m_componentStorages.size())
+		{
+			// Tag types have no collections
+			if (m_componentStorages[m_compactionStep])
+			{
+				m_componentStorages[m_compactionStep]->Compact();
+			}
+		}
+		else
+		{
+			m_archetypeStorage.Compact();
+			m_entitiesCollection.Compact();
+
+			// Scratch blocks are allocated again by the next frames, which need them
+			for (auto& frameAllocator : m_frameAllocators)
+			{
+				frameAllocator->ReleaseBlocks();
+			}
+		}
+
+		++m_compactionStep;
+
+		if (timeBudget > std::chrono::nanoseconds::zero() && std::chrono::steady_clock::now() - startTime >= timeBudget)
+			break;
+	}
+
+	if (m_compactionStep < stepsCount)
+		return false;
+
+	m_compactionStep = 0U;
+	return true;
+}
+
 ComponentPtr Manager::CreateComponentByName(const std::string& name)
 {
 	auto typeIdIt = m_componentNameToIdMapping.find(name);
@@ -230,9 +358,57 @@ ComponentPtr Manager::CreateComponentByTypeId(const ComponentTypeId typeId)
 
 ComponentPtr Manager::CreateComponentInternal(const ComponentTypeId typeId)
 {
+	assert(!IsTagType(typeId) && "Tags have no components, use Entity::AddTag");
 	return GetCollection(typeId)->Create();
 }
 
+void Manager::CreateComponentsByTypeId(const ComponentTypeId typeId, const std::size_t count, ComponentPtr* outComponents)
+{
+	assert(!IsTagType(typeId) && "Tags have no components, use Entity::AddTag");
+	GetCollection(typeId)->CreateComponents(count, outComponents);
+}
+
+void Manager::DestroyComponents(ComponentPtr* components, const std::size_t count)
+{
+	std::pmr::vector<std::size_t> batchIndexes(GetMemoryResource());
+	batchIndexes.reserve(count);
+	ComponentTypeId batchTypeId = GetInvalidComponentTypeId();
+
+	auto flushBatch = [this, &batchIndexes, &batchTypeId]()
+	{
+		if (!batchIndexes.empty())
+		{
+			GetCollection(batchTypeId)->DestroyComponents(batchIndexes.data(), batchIndexes.size());
+			batchIndexes.clear();
+		}
+	};
+
+	for (std::size_t i = 0U; i < count; ++i)
+	{
+		ComponentPtr& component = components[i];
+		if (!component.IsValid())
+			continue;
+
+		// Shared components (including attached to entities) are just released by handle
+		if (component.m_block->refCount != 1)
+		{
+			component.Reset();
+			continue;
+		}
+
+		if (component.m_block->typeId != batchTypeId)
+		{
+			flushBatch();
+			batchTypeId = component.m_block->typeId;
+		}
+
+		batchIndexes.push_back(static_cast<std::size_t>(component.m_block->dataIndex));
+		component.m_block = nullptr;
+	}
+
+	flushBatch();
+}
+
 void Manager::ReleaseComponent(ComponentTypeId componentType, int32_t index)
 {
 	GetCollection(componentType)->Destroy(index);
@@ -249,6 +425,11 @@ ComponentTypeId Manager::GetComponentTypeIdByIndex(const std::type_index& typeIn
 	return GetInvalidComponentTypeId();
 }
 
+bool Manager::IsTagType(const ComponentTypeId typeId) const
+{
+	return typeId >= 0 && static_cast<std::size_t>(typeId) < m_tagTypesMask.size() && m_tagTypesMask.test(typeId);
+}
+
 ComponentTypeId Manager::GetComponentTypeIdByName(const std::string& name) const
 {
 	auto it = m_componentNameToIdMapping.find(name);
@@ -278,12 +459,21 @@ EntitiesCollection& Manager::GetEntitiesCollection()
 
 void Manager::RegisterComponentTypeInternal(const std::string& name, const std::type_index& typeIndex, const ComponentTypeId typeId, std::unique_ptr<IComponentCollection>&& collection)
 {
+	assert(static_cast<std::size_t>(typeId) < MaxComponentTypesCount && "Increase ECS_MAX_COMPONENT_TYPES");
+
 	// Register type storage
 	m_componentStorages.emplace_back(std::move(collection));
 	m_componentNameToIdMapping.emplace(name, typeId);
 	m_componentTypeIndexes.push_back(typeIndex);
 	m_typeIndexToComponentTypeIdMapping.emplace(typeIndex, typeId);
 
+	const uint32_t sequenceIndex = detail::GetTypeSequenceIndex(detail::TypeFamily::Component, typeIndex);
+	if (sequenceIndex >= m_componentTypeIdsBySequence.size())
+	{
+		m_componentTypeIdsBySequence.resize(sequenceIndex + 1U, GetInvalidComponentTypeId());
+	}
+	m_componentTypeIdsBySequence[sequenceIndex] = typeId;
+
 	// Register caches link
 	m_componentTypeCaches.emplace(typeId, std::vector<ComponentsTupleCache*>());
 }
@@ -414,6 +604,11 @@ EntityCreateDelegate& Manager::GetEntityCreateDelegate()
 	return m_entityCreateDelegate;
 }
 
+EntitiesInstantiateDelegate& Manager::GetEntitiesInstantiateDelegate()
+{
+	return m_entitiesInstantiateDelegate;
+}
+
 EntityDestroyDelegate& Manager::GetEntityDestroyDelegate()
 {
 	return m_entityDestroyDelegate;
@@ -429,6 +624,88 @@ Entity Manager::CreateEntity()
 	return m_entitiesCollection.CreateEntity();
 }
 
+void Manager::Instantiate(const Prefab& prefab, const std::size_t count, Entity* outRoots)
+{
+	const std::pmr::vector<Prefab::Node>& nodes = prefab.GetNodes();
+	if (nodes.empty() || count == 0U)
+		return;
+
+	// Entities are grouped by prefab node, so copies of the same node are contiguous
+	std::pmr::vector<Entity> entities(nodes.size() * count, GetMemoryResource());
+	m_entitiesCollection.CreateEntities(entities.size(), entities.data());
+
+	std::pmr::vector<EntityData*> nodeEntitiesData(count, GetMemoryResource());
+	std::pmr::vector<EntityId> nodeEntityIds(count, GetMemoryResource());
+	std::pmr::vector<ComponentPtr> componentClones(count, GetMemoryResource());
+
+	for (std::size_t nodeIndex = 0U; nodeIndex < nodes.size(); ++nodeIndex)
+	{
+		const Prefab::Node& node = nodes[nodeIndex];
+		Entity* nodeEntities = entities.data() + nodeIndex * count;
+
+		// Mask includes components and tags, so it is assigned once
+		for (std::size_t i = 0U; i < count; ++i)
+		{
+			EntityData* entityData = m_entitiesCollection.GetEntityData(nodeEntities[i].GetId());
+			entityData->componentsMask = node.componentsMask;
+			entityData->components.reserve(node.componentsCount);
+
+			nodeEntitiesData[i] = entityData;
+			nodeEntityIds[i] = entityData->id;
+		}
+
+		if (!node.name.empty())
+		{
+			for (std::size_t i = 0U; i < count; ++i)
+			{
+				nodeEntities[i].SetName(node.name);
+			}
+		}
+
+		// Copies of every node component are created in one batch, and appended in type id order
+		for (uint32_t componentIndex = node.firstComponent; componentIndex < node.firstComponent + node.componentsCount; ++componentIndex)
+		{
+			const ComponentPtr& component = prefab.GetComponents()[componentIndex];
+			IComponentCollection* collection = GetCollection(component.m_block->typeId);
+			collection->CloneComponents(component.m_block->dataIndex, count, componentClones.data());
+
+			for (std::size_t i = 0U; i < count; ++i)
+			{
+				ComponentPtr& clone = componentClones[i];
+				clone.m_block->entityId = nodeEntityIds[i];
+				collection->OnComponentEntityChanged(clone.m_block->dataIndex, nodeEntityIds[i]);
+				nodeEntitiesData[i]->components.push_back(std::move(clone));
+			}
+		}
+
+		if (node.parentIndex != Prefab::k_invalidNodeIndex)
+		{
+			Entity* parentEntities = entities.data() + node.parentIndex * count;
+			for (std::size_t i = 0U; i < count; ++i)
+			{
+				parentEntities[i].AddChild(nodeEntities[i]);
+			}
+		}
+
+		// Caches are matched against node mask once
+		for (auto& cacheEntry : m_tupleCaches)
+		{
+			ComponentsTupleCache* cache = cacheEntry.second.get();
+			if (node.componentsMask.Contains(cache->GetComponentsMask()))
+			{
+				cache->AddEntities(nodeEntityIds.data(), count);
+			}
+		}
+	}
+
+	m_entitiesInstantiateDelegate.Broadcast(entities.data(), entities.size());
+
+	for (std::size_t i = 0U; i < count; ++i)
+	{
+		outRoots[i] = std::move(entities[i]);
+	}
+}
+
 void* Manager::GetComponentRaw(ComponentTypeId componentType, int32_t index)
 {
 	auto collection = GetCollection(componentType);
@@ -445,9 +722,9 @@ Manager* Manager::Get()
 	return ManagerInstance;
 }
 
-void Manager::InitECSManager()
+void Manager::InitECSManager(std::pmr::memory_resource* resource)
 {
-	ManagerInstance = new Manager();
+	ManagerInstance = new Manager(resource);
 }
 
 void Manager::ShutdownECSManager()
@@ -460,17 +737,12 @@ void Manager::ShutdownECSManager()
 	}
 }
 
-ComponentTypeId Manager::GetInvalidComponentTypeId()
-{
-	return std::numeric_limits<ComponentTypeId>::max();
-}
-
 uint32_t Manager::RegisterComponentsTupleIterator(std::vector<ComponentTypeId>& typeIds)
 {
 	if (typeIds.size() > 0)
 	{
 		uint32_t typeIdsHash = GetComponentsTupleId(typeIds);
-		std::unique_ptr<ComponentsTupleCache> cache = std::make_unique<ComponentsTupleCache>(typeIds.data(), typeIds.size());
+		std::unique_ptr<ComponentsTupleCache> cache = std::make_unique<ComponentsTupleCache>(typeIds.data(), typeIds.size(), GetMemoryResource());
 		ComponentsTupleCache* cachePtr = cache.get();
 		m_tupleCaches.emplace(std::piecewise_construct, std::forward_as_tuple(typeIdsHash), std::forward_as_tuple(std::move(cache)));
 
@@ -496,16 +768,7 @@ void Manager::DefaultComponentAttachedDelegate(ecs::Entity entity, ecs::Componen
 	GetSpecializedComponentAttachedDelegate(component.GetTypeId()).Broadcast(entity, component);
 
 	// Touch tuple caches
-	ComponentTypeId typeId = component.GetTypeId();
-	auto it = m_componentTypeCaches.find(typeId);
-	if (it != m_componentTypeCaches.end())
-	{
-		const auto& cachesList = it->second;
-		for (ComponentsTupleCache* cache : cachesList)
-		{
-			cache->TouchEntity(entity.GetId());
-		}
-	}
+	TouchTypeCaches(entity.GetId(), component.GetTypeId());
 }
 
 void Manager::DefaultComponentDetachedDelegate(ecs::ComponentPtr component)
@@ -517,7 +780,21 @@ void Manager::DefaultComponentDetachedDelegate(ecs::ComponentPtr component)
 void Manager::HandleComponentDetach(const ecs::EntityId entityId, const ecs::ComponentPtr& component)
 {
 	// Touch tuple caches
-	ComponentTypeId typeId = component.GetTypeId();
+	TouchTypeCaches(entityId, component.GetTypeId());
+
+	m_componentDetachedDelegate.Broadcast(component);
+}
+
+void Manager::HandleTagsDetach(const ecs::EntityId entityId, const ComponentMaskType& componentsMask)
+{
+	const ComponentMaskType tagsMask = componentsMask & m_tagTypesMask;
+	tagsMask.ForEachSetBit([this, entityId](const std::size_t typeId) {
+		TouchTypeCaches(entityId, static_cast<ComponentTypeId>(typeId));
+	});
+}
+
+void Manager::TouchTypeCaches(const ecs::EntityId entityId, const ComponentTypeId typeId)
+{
 	auto it = m_componentTypeCaches.find(typeId);
 	if (it != m_componentTypeCaches.end())
 	{
@@ -527,8 +804,6 @@ void Manager::HandleComponentDetach(const ecs::EntityId entityId, const ecs::Com
 			cache->TouchEntity(entityId);
 		}
 	}
-
-	m_componentDetachedDelegate.Broadcast(component);
 }
 
 void Manager::AddEntityLayer(const std::string& layerName, std::unique_ptr<EntityLayer>&& layer)
@@ -1,15 +1,28 @@
 #pragma once
+#include <chrono>
+#include <limits>
 #include <vector>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <unordered_map>
 #include <typeindex>
+#include <type_traits>
 #include <vector>
 
 #include "ecs/component/ComponentCollectionImpl.hpp"
+#include "ecs/component/DenseComponentCollection.hpp"
+#include "ecs/component/SoAComponentCollection.hpp"
+#include "ecs/component/ArchetypeComponentCollection.hpp"
+#include "ecs/component/HashMapComponentCollection.hpp"
+#include "ecs/component/CollectionAlignment.hpp"
+#include "ecs/component/ComponentStorageTraits.hpp"
+#include "ecs/storage/FrameAllocator.hpp"
+#include "ecs/detail/TypeSequence.hpp"
 #include "ecs/System.hpp"
 #include "ecs/entity/EntitiesCollection.hpp"
 #include "ecs/entity/EntityLayer.hpp"
+#include "ecs/entity/Prefab.hpp"
 #include "ecs/cache/ComponentsTupleCache.hpp"
 #include "ecs/cache/GenericComponentsCacheView.hpp"
 #include "ecs/cache/TypedComponentsCacheView.hpp"
@@ -17,6 +30,7 @@
 
 DECLARE_MULTICAST_DELEGATE(EntityCreateDelegate, ecs::Entity);
 DECLARE_MULTICAST_DELEGATE(EntityDestroyDelegate, ecs::EntityId);
+DECLARE_MULTICAST_DELEGATE(EntitiesInstantiateDelegate, const ecs::Entity*, std::size_t);
 DECLARE_MULTICAST_DELEGATE(ComponentCreateDelegate, ecs::ComponentPtr);
 DECLARE_MULTICAST_DELEGATE(ComponentDestroyDelegate, ecs::ComponentPtr);
 DECLARE_MULTICAST_DELEGATE(ComponentAttachedDelegate, ecs::Entity&, ecs::ComponentPtr);
@@ -35,9 +49,14 @@ class Manager
 	friend class ComponentPtr;
 	friend struct Entity;
 	friend class ComponentsTupleCache;
+	friend struct ComponentHandle;
 
 public:
-	ECS_API Manager();
+	/**
+	* @brief Creates manager, which allocates storages, entities and caches from provided memory resource.
+	* Resource must outlive the manager, null resource means global heap.
+	*/
+	ECS_API explicit Manager(std::pmr::memory_resource* resource = nullptr);
 
 	void ECS_API Init();
 	void ECS_API Destroy();
@@ -75,7 +94,8 @@ public:
 	{
 		static_assert(std::is_base_of<System, SystemType>::value, "System type must be derived from ecs::System!");
 
-		System* system = GetSystemByTypeIndex(typeid(SystemType));
+		const uint32_t sequenceIndex = detail::TypeSequenceIndex<detail::TypeFamily::System, SystemType>();
+		System* system = (sequenceIndex < m_systemsBySequence.size()) ? m_systemsBySequence[sequenceIndex] : nullptr;
 		return static_cast<SystemType*>(system);
 	}
 
@@ -83,34 +103,144 @@ public:
 
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+	/**
+	* @brief Sets allocation policy used by storages of component types, registered after this call.
+	* Policy memory resource is ignored, storages always allocate from the manager memory resource.
+	*/
+	void ECS_API SetAllocationPolicy(const AllocationPolicy& policy);
+	ECS_API const AllocationPolicy& GetAllocationPolicy() const;
+
+	// Returns memory resource, used by manager storages (default resource, if manager allocates from global heap)
+	ECS_API std::pmr::memory_resource* GetMemoryResource() const;
+
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	// Section for per frame scratch memory
+
+	/**
+	* @brief Returns scratch allocator for temporary data of the current update, which is reset at the end of Update.
+	* Allocator 0 belongs to the thread running Update, worker threads must use their own allocators.
+	*/
+	ECS_API FrameAllocator& GetFrameAllocator(const std::size_t threadIndex = 0U);
+
+	// Creates frame allocators for worker threads, must not be called during update
+	void ECS_API SetFrameAllocatorsCount(const std::size_t threadsCount);
+	std::size_t ECS_API GetFrameAllocatorsCount() const;
+
+	/**
+	* @brief Releases storages memory, which isn't used by alive components and entities (empty pool rooms and chunks,
+	* unused arrays capacity, destroyed entities at the end of entities storage), and frees scratch allocators blocks.
+	* Compaction pass is split into steps (a step per component collection), and when time budget is provided,
+	* pass is paused after the step, which exceeded the budget, and continued by the next call.
+	* @param timeBudget - time limit of the call, zero runs the whole pass
+	* @return True if compaction pass has been finished
+	*/
+	bool ECS_API Compact(const std::chrono::nanoseconds timeBudget = std::chrono::nanoseconds::zero());
+
+	/**
+	* @brief Registers component type, creating its collection. Collection type is selected by ComponentStorageTraits.
+	* Empty types are registered as tags (see RegisterTagType).
+	*/
 	template <typename ComponentType>
 	void RegisterComponentType(const std::string& name)
 	{
+		if constexpr (std::is_empty<ComponentType>::value)
+		{
+			RegisterTagType<ComponentType>(name);
+		}
+		else
+		{
+			ComponentTypeId typeId = static_cast<ComponentTypeId>(m_componentStorages.size());
+			using CollectionType = ComponentCollectionT<ComponentType>;
+
+			std::unique_ptr<CollectionType> collection;
+			if constexpr (std::is_constructible<CollectionType, ComponentTypeId, const AllocationPolicy&>::value)
+			{
+				collection = std::make_unique<CollectionType>(typeId, m_allocationPolicy);
+			}
+			else
+			{
+				collection = std::make_unique<CollectionType>(typeId);
+			}
+
+			if constexpr (std::is_same<CollectionType, ArchetypeComponentCollection<ComponentType>>::value)
+			{
+				collection->SetStorage(&m_archetypeStorage);
+			}
+
+			RegisterComponentTypeInternal(name, typeid(ComponentType), typeId, std::move(collection));
+		}
+	}
+
+	/**
+	* @brief Registers tag type, which has no storage and exists only as a bit in entity components mask.
+	* Tags are added with Entity::AddTag, and can be used in tuple queries, where their handles are empty.
+	*/
+	template <typename TagType>
+	void RegisterTagType(const std::string& name)
+	{
+		static_assert(std::is_empty<TagType>::value, "Tag type must be empty");
+
 		ComponentTypeId typeId = static_cast<ComponentTypeId>(m_componentStorages.size());
-		auto collection = std::make_unique<ComponentCollectionImpl<ComponentType>>(typeId);
-		
-		RegisterComponentTypeInternal(name, typeid(ComponentType), typeId, std::move(collection));
+		RegisterComponentTypeInternal(name, typeid(TagType), typeId, nullptr);
+		m_tagTypesMask.set(typeId);
+	}
+
+	bool ECS_API IsTagType(const ComponentTypeId typeId) const;
+
+	// Mask of all registered tag types
+	const ComponentMaskType& GetTagTypesMask() const
+	{
+		return m_tagTypesMask;
+	}
+
+	/**
+	* @brief Creates component of registered type, constructing it directly in its final storage slot
+	* @param args - component constructor arguments (aggregate components are brace initialized)
+	*/
+	template <typename ComponentType, typename ...Args>
+	TComponentPtr<ComponentType> CreateComponent(Args&&... args)
+	{
+		static_assert(!std::is_empty<ComponentType>::value, "Tags have no components, use Entity::AddTag");
+		ComponentCollectionT<ComponentType>* collection = GetComponentCollection<ComponentType>();
+		assert(nullptr != collection);
+
+		return collection->Emplace(std::forward<Args>(args)...);
 	}
 
+	/**
+	* @brief Creates count default components of registered type at once, reserving storage space once
+	* @param outComponents - array of count empty handles, which receives created components
+	*/
 	template <typename ComponentType>
-	TComponentPtr<ComponentType> CreateComponent()
+	void CreateComponents(const std::size_t count, TComponentPtr<ComponentType>* outComponents)
 	{
-		ComponentTypeId typeId = GetComponentTypeIdByIndex(typeid(ComponentType));
-		return TComponentPtr<ComponentType>(CreateComponentInternal(typeId));
+		static_assert(!std::is_empty<ComponentType>::value, "Tags have no components, use Entity::AddTag");
+		ComponentCollectionT<ComponentType>* collection = GetComponentCollection<ComponentType>();
+		assert(nullptr != collection);
+
+		collection->CreateComponents(count, outComponents);
 	}
 
+	void ECS_API CreateComponentsByTypeId(const ComponentTypeId typeId, const std::size_t count, ComponentPtr* outComponents);
+
+	/**
+	* @brief Releases count component handles. Components, which are referenced only by these handles, are destroyed
+	* in batches per type, the rest of handles are just reset.
+	*/
+	void ECS_API DestroyComponents(ComponentPtr* components, const std::size_t count);
+
 	ECS_API void* GetComponentRaw(ComponentTypeId componentType, int32_t index);
 	ComponentPtr ECS_API CreateComponentByName(const std::string& name);
 	ComponentPtr ECS_API CreateComponentByTypeId(const ComponentTypeId typeId);
 	void ECS_API MoveComponentData(const ComponentPtr& handle, void* dataPtr);
 
 	template <typename ComponentType>
-	ComponentCollectionImpl<ComponentType>* GetComponentCollection()
+	ComponentCollectionT<ComponentType>* GetComponentCollection()
 	{
-		auto it = m_typeIndexToComponentTypeIdMapping.find(typeid(ComponentType));
-		if (it != m_typeIndexToComponentTypeIdMapping.end())
+		const ComponentTypeId typeId = GetComponentTypeId<ComponentType>();
+		if (GetInvalidComponentTypeId() != typeId)
 		{
-			return static_cast<ComponentCollectionImpl<ComponentType>*>(GetCollection(it->second));
+			return static_cast<ComponentCollectionT<ComponentType>*>(m_componentStorages[typeId].get());
 		}
 		
 		return nullptr;
@@ -125,10 +255,16 @@ public:
 	ComponentTypeId ECS_API GetComponentTypeIdByName(const std::string& name) const;
 	std::type_index ECS_API GetComponentTypeIndexByTypeId(const ComponentTypeId typeId) const;
 
+	// Typed lookup is an array access by type sequence index, without hashing
 	template <typename ComponentType>
 	ComponentTypeId GetComponentTypeId() const
 	{
-		return GetComponentTypeIdByIndex(typeid(ComponentType));
+		return GetComponentTypeIdBySequence(detail::TypeSequenceIndex<detail::TypeFamily::Component, ComponentType>());
+	}
+
+	ComponentTypeId GetComponentTypeIdBySequence(const uint32_t sequenceIndex) const
+	{
+		return (sequenceIndex < m_componentTypeIdsBySequence.size()) ? m_componentTypeIdsBySequence[sequenceIndex] : GetInvalidComponentTypeId();
 	}
 
 	ComponentPtr ECS_API CloneComponent(const ComponentPtr& componentPtr);
@@ -138,6 +274,7 @@ public:
 
 	ECS_API EntityCreateDelegate& GetEntityCreateDelegate();
 	ECS_API EntityDestroyDelegate& GetEntityDestroyDelegate();
+	ECS_API EntitiesInstantiateDelegate& GetEntitiesInstantiateDelegate();
 	ECS_API ComponentCreateDelegate& GetComponentCreateDelegate();
 	ECS_API ComponentDestroyDelegate& GetComponentDestroyDelegate();
 	ECS_API ComponentAttachedDelegate& GetComponentAttachedDelegate();
@@ -151,6 +288,40 @@ public:
 	Entity ECS_API GetEntityById(const EntityId id);
 	Entity ECS_API CreateEntity();
 
+	/**
+	* @brief Creates count copies of the prefab entities at once. Entities and components of every prefab node are created
+	* in batches (components are copy constructed from the prefab components), entity masks are assigned once, and tuple
+	* caches, matching the node, receive all its copies at once.
+	* Only entities instantiate delegate is invoked: it is broadcast once with all created entities, grouped by prefab node.
+	* Entity create delegate, and component attached delegates (global and specialized) aren't invoked for the copies,
+	* so their listeners must subscribe to entities instantiate delegate too.
+	* @param outRoots - array of count empty entities, which receives copies of the prefab root
+	*/
+	void ECS_API Instantiate(const Prefab& prefab, const std::size_t count, Entity* outRoots);
+
+	/**
+	* @brief Calls func(Entity&) for the root entity and all its descendants in depth first order (parent before
+	* its children, children in their order). Hierarchy must not be changed by func.
+	*/
+	template <typename Func>
+	void ForEachInHierarchy(const Entity& root, Func&& func)
+	{
+		m_entitiesCollection.ForEachInHierarchy(root, std::forward<Func>(func));
+	}
+
+	/**
+	* @brief Iterates entities grouped by hierarchy depth, from roots to the deepest level, for parent before child passes
+	* (transform propagation, state inheritance). Invokes func(uint16_t depth, std::size_t count, const EntityId* entities,
+	* const EntityId* parents) for every level, parents are in the previous level (invalid id for roots). Entities of a level
+	* are independent, so func can split the level between worker threads, waiting for them before returning.
+	* Levels are maintained by hierarchy changes, hierarchy must not be changed during iteration.
+	*/
+	template <typename Func>
+	void ForEachHierarchyLevel(Func&& func) const
+	{
+		m_entitiesCollection.ForEachHierarchyLevel(std::forward<Func>(func));
+	}
+
 	///////////////////////////////////////////////////////////////////////////////////
 	// Component cache views section
 
@@ -183,6 +354,22 @@ public:
 		return TypedComponentsCacheView<ComponentT...>(tupleCache);
 	}
 
+	/**
+	* @brief Iterates archetype chunks of all the entities, having all provided components (stored in archetype collections).
+	* Invokes func(std::size_t count, const EntityId* entities, ComponentT*... components) for every chunk,
+	* components must not be attached or detached from archetype stored types during iteration.
+	*/
+	template <class ...ComponentT, typename Func>
+	void ForEachArchetypeChunk(Func&& func)
+	{
+		m_archetypeStorage.ForEachChunk<ComponentT...>({ GetComponentTypeId<ComponentT>()... }, std::forward<Func>(func));
+	}
+
+	ArchetypeStorage& GetArchetypeStorage()
+	{
+		return m_archetypeStorage;
+	}
+
 	void ECS_API AddEntityLayer(const std::string& layerName, std::unique_ptr<EntityLayer>&& layer);
 	void ECS_API RemoveEntityLayer(const std::string& layerName);
 	ECS_API EntityLayer* GetEntityLayer(const std::string& layerName) const;
@@ -211,10 +398,13 @@ public:
 	// Static section
 
 	static ECS_API Manager* Get();
-	static void ECS_API InitECSManager();
+	static void ECS_API InitECSManager(std::pmr::memory_resource* resource = nullptr);
 	static void ECS_API ShutdownECSManager();
 
-	static ComponentTypeId ECS_API GetInvalidComponentTypeId();
+	static constexpr ComponentTypeId GetInvalidComponentTypeId()
+	{
+		return std::numeric_limits<ComponentTypeId>::max();
+	}
 
 private:
 	/**
@@ -254,7 +444,7 @@ private:
 	std::vector<ComponentTypeId> ComposeTypeIdsVector() const
 	{
 		std::vector<ComponentTypeId> typeIds;
-		(typeIds.push_back(GetComponentTypeIdByIndex(typeid(ComponentT))), ...);
+		(typeIds.push_back(GetComponentTypeId<ComponentT>()), ...);
 
 		return typeIds;
 	}
@@ -263,15 +453,27 @@ private:
 	void DefaultComponentDetachedDelegate(ecs::ComponentPtr component);
 
 	void HandleComponentDetach(const ecs::EntityId entityId, const ecs::ComponentPtr& component);
+	void HandleTagsDetach(const ecs::EntityId entityId, const ComponentMaskType& componentsMask);
+
+	// Updates entity membership in all tuple caches, which include the component type
+	void TouchTypeCaches(const ecs::EntityId entityId, const ComponentTypeId typeId);
+
+	void ResetFrameAllocators();
 
 private:
+	AllocationPolicy m_allocationPolicy;
+	ArchetypeStorage m_archetypeStorage; // Shared storage of components with archetype collections, must outlive the collections
+	std::vector<std::unique_ptr<FrameAllocator>> m_frameAllocators; // Scratch allocator per update thread
 	std::vector<std::unique_ptr<IComponentCollection>> m_componentStorages;
 	std::vector<std::type_index> m_componentTypeIndexes;
 	std::unordered_map<std::string, ComponentTypeId> m_componentNameToIdMapping;
 	std::unordered_map<std::type_index, ComponentTypeId> m_typeIndexToComponentTypeIdMapping;
+	std::vector<ComponentTypeId> m_componentTypeIdsBySequence; // Component type ids by type sequence index, for typed lookups
+	ComponentMaskType m_tagTypesMask; // Types without storage (their collections are null)
 
 	std::vector<SystemPtr> m_systemsStorage; // Systems that are created just inside ecs manager, and owned by the external code
 	std::unordered_map<std::type_index, System*> m_systemsTypeIdMapping; // Mapping of type id to the systems
+	std::vector<System*> m_systemsBySequence; // Systems by type sequence index, for typed lookups
 	std::vector<System*> m_orderedSystems; // Ordered systems pointers list, for strict execution order
 
 	// Pairs of new systems, that have not been initialized yet, and will be initialized at next update,
@@ -289,6 +491,7 @@ private:
 	// Global ecs state delegates
 	EntityCreateDelegate m_entityCreateDelegate;
 	EntityDestroyDelegate m_entityDestroyDelegate;
+	EntitiesInstantiateDelegate m_entitiesInstantiateDelegate;
 	ComponentCreateDelegate m_componentCreateDelegate;
 	ComponentDestroyDelegate m_componentDestroyDelegate;
 	ComponentAttachedDelegate m_componentAttachedDelegate;
@@ -300,6 +503,8 @@ private:
 	std::unordered_map<ComponentTypeId, ComponentAttachedDelegate> m_componentSpecificAttachDelegates;
 	std::unordered_map<ComponentTypeId, ComponentDetachedDelegate> m_componentSpecificDetachDelegates;
 
+	std::size_t m_compactionStep = 0U; // Next step of incremental compaction pass
+
 	bool m_systemPrioritiesChanged = true; // Flag, indicating that systems need to be sorted prior next update
 	bool m_isUpdatingSystems = false; // Flag, indicating that manager is currently updating exisiting systems
 	bool m_isBeingDestroyed = false;
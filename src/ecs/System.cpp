@@ -65,6 +65,11 @@ const std::vector<std::type_index>& System::GetUpdateDependenciesList() const
 	return m_updateDependencies;
 }
 
+FrameAllocator& System::GetFrameAllocator(const std::size_t threadIndex) const
+{
+	return Manager::Get()->GetFrameAllocator(threadIndex);
+}
+
 bool System::operator<(const System& other) const
 {
 	return GetPriority() > other.GetPriority();
@@ -6,6 +6,8 @@
 namespace ecs
 {
 
+class FrameAllocator;
+
 // System is a class, that has lifecycle callbacks Init, Destroy and Update,
 // and has integer priority, which is used to determine system's order inside systems collection
 class System
@@ -44,6 +46,9 @@ public:
 
 	ECS_API const std::vector<std::type_index>& GetUpdateDependenciesList() const;
 
+	// Scratch allocator for temporary data of the current update (see Manager::GetFrameAllocator)
+	ECS_API FrameAllocator& GetFrameAllocator(const std::size_t threadIndex = 0U) const;
+
 private:
 	void DispatchInit();
 	void DispatchDestroy();
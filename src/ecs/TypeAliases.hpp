@@ -1,7 +1,13 @@
 #pragma once
 #include <cstdint>
 #include <cstddef>
-#include <bitset>
+#include "ecs/detail/ComponentMask.hpp"
+
+// Width of the components mask, can be overridden by the build (see ECS_MAX_COMPONENT_TYPES in CMakeLists.txt).
+// Changes layout of entity data, so the library and its users must be built with the same value.
+#ifndef ECS_MAX_COMPONENT_TYPES
+#define ECS_MAX_COMPONENT_TYPES 256
+#endif
 
 namespace ecs
 {
@@ -11,9 +17,9 @@ namespace detail
 template <class T> class MemoryPool;
 }
 
-using EntityId = int32_t;
-const std::size_t MaxComponentTypesCount = 128U;
-using ComponentMaskType = std::bitset<MaxComponentTypesCount>;
+using EntityId = int64_t;
+const std::size_t MaxComponentTypesCount = ECS_MAX_COMPONENT_TYPES;
+using ComponentMaskType = detail::ComponentMask<MaxComponentTypesCount>;
 using EntityHandleIndex = uint32_t;
 using ComponentTypeId = int32_t;
 
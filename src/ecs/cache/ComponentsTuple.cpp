@@ -1,14 +1,18 @@
 #include "ecs/cache/ComponentsTuple.hpp"
 
+#include <memory>
+
 namespace ecs
 {
 
-ComponentsTuple::ComponentsTuple(const std::size_t tupleSize)
-	: m_size(tupleSize)
+ComponentsTuple::ComponentsTuple(const std::size_t tupleSize, std::pmr::memory_resource* resource)
+	: m_resource(resource)
+	, m_size(tupleSize)
 {
 	if (m_size > 0)
 	{
-		m_data = new ComponentPtr[m_size];
+		m_data = static_cast<ComponentHandle*>(m_resource->allocate(sizeof(ComponentHandle) * m_size, alignof(ComponentHandle)));
+		std::uninitialized_default_construct_n(m_data, m_size);
 	}
 }
 
@@ -16,14 +20,16 @@ ComponentsTuple::~ComponentsTuple()
 {
 	if (nullptr != m_data)
 	{
-		delete[] m_data;
+		std::destroy_n(m_data, m_size);
+		m_resource->deallocate(m_data, sizeof(ComponentHandle) * m_size, alignof(ComponentHandle));
 		m_data = nullptr;
 	}
 }
 
 // Move is enabled
 ComponentsTuple::ComponentsTuple(ComponentsTuple&& other)
-	: m_data(other.m_data)
+	: m_resource(other.m_resource)
+	, m_data(other.m_data)
 	, m_size(other.m_size)
 {
 	other.m_data = nullptr;
@@ -32,6 +38,7 @@ ComponentsTuple::ComponentsTuple(ComponentsTuple&& other)
 
 ComponentsTuple& ComponentsTuple::operator=(ComponentsTuple&& other)
 {
+	m_resource = other.m_resource;
 	m_data = other.m_data;
 	m_size = other.m_size;
 
@@ -41,12 +48,12 @@ ComponentsTuple& ComponentsTuple::operator=(ComponentsTuple&& other)
 	return *this;
 }
 
-const ComponentPtr* ComponentsTuple::GetData() const
+const ComponentHandle* ComponentsTuple::GetData() const
 {
 	return m_data;
 }
 
-ComponentPtr* ComponentsTuple::GetMutableData()
+ComponentHandle* ComponentsTuple::GetMutableData()
 {
 	return m_data;
 }
@@ -56,12 +63,12 @@ const std::size_t ComponentsTuple::GetSize() const
 	return m_size;
 }
 
-ComponentPtr& ComponentsTuple::operator[](const std::size_t index)
+ComponentHandle& ComponentsTuple::operator[](const std::size_t index)
 {
 	return m_data[index];
 }
 
-const ComponentPtr& ComponentsTuple::operator[](const std::size_t index) const
+const ComponentHandle& ComponentsTuple::operator[](const std::size_t index) const
 {
 	return m_data[index];
 }
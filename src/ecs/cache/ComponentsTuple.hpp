@@ -1,7 +1,9 @@
 #pragma once
 #include "ecs/detail/Types.hpp"
 #include "ecs/component/ComponentPtr.hpp"
+#include "ecs/component/ComponentHandle.hpp"
 
+#include <memory_resource>
 #include <tuple>
 
 namespace ecs
@@ -10,10 +12,18 @@ namespace ecs
 template <typename ...ComponentTypes>
 using ComponentTupleT = std::tuple<TComponentPtr<ComponentTypes>...>;
 
+template <typename ...ComponentTypes>
+using ComponentHandlesTupleT = std::tuple<TComponentHandle<ComponentTypes>...>;
+
+/**
+* @brief Cached components of an entity. Cache stores lightweight handles, so it doesn't keep components alive
+* and doesn't touch reference counters, tags entries are null handles.
+*/
 struct ECS_API ComponentsTuple
 {
 	ComponentsTuple() = delete;
-	ComponentsTuple(const std::size_t tupleSize);
+	// Components array is allocated from provided memory resource
+	ComponentsTuple(const std::size_t tupleSize, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 	~ComponentsTuple();
 
 	// Copy is disabled
@@ -24,12 +34,12 @@ struct ECS_API ComponentsTuple
 	ComponentsTuple(ComponentsTuple&& other);
 	ComponentsTuple& operator=(ComponentsTuple&& other);
 
-	const ComponentPtr* GetData() const;
-	ComponentPtr* GetMutableData();
+	const ComponentHandle* GetData() const;
+	ComponentHandle* GetMutableData();
 	const std::size_t GetSize() const;
 
-	ComponentPtr& operator[](const std::size_t index);
-	const ComponentPtr& operator[](const std::size_t index) const;
+	ComponentHandle& operator[](const std::size_t index);
+	const ComponentHandle& operator[](const std::size_t index) const;
 
 	// Conversion utils
 	template <typename ...ComponentTypes>
@@ -39,6 +49,19 @@ struct ECS_API ComponentsTuple
 		return PopulateTuple<TupleT>();
 	}
 
+	// Lightweight handles don't touch reference counters
+	template <typename ...ComponentTypes>
+	ComponentHandlesTupleT<ComponentTypes...> GetTypedHandles() const
+	{
+		return GetTypedHandlesImpl<ComponentTypes...>(std::index_sequence_for<ComponentTypes...>{});
+	}
+
+	template <typename ...ComponentTypes, std::size_t... I>
+	ComponentHandlesTupleT<ComponentTypes...> GetTypedHandlesImpl(std::index_sequence<I...>) const
+	{
+		return ComponentHandlesTupleT<ComponentTypes...>(TComponentHandle<ComponentTypes>(m_data[I])...);
+	}
+
 	template <typename Tuple, std::size_t N = std::tuple_size<Tuple>::value, typename Indices = std::make_index_sequence<N>>
 	Tuple PopulateTuple()
 	{
@@ -48,11 +71,12 @@ struct ECS_API ComponentsTuple
 	template <typename Tuple, std::size_t... I>
 	Tuple PopulateTupleImpl(std::index_sequence<I...>)
 	{
-		return Tuple(m_data[I]...);
+		return Tuple(std::tuple_element_t<I, Tuple>(m_data[I].ToPtr())...);
 	}
 
 private:
-	ComponentPtr* m_data;
+	std::pmr::memory_resource* m_resource;
+	ComponentHandle* m_data = nullptr;
 	std::size_t m_size;
 };
 
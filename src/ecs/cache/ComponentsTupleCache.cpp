@@ -1,20 +1,27 @@
 #include "ecs/cache/ComponentsTupleCache.hpp"
 #include "ecs/entity/Entity.hpp"
 #include "ecs/Manager.hpp"
+#include <cassert>
 #include <cstring>
 #include <algorithm>
 
 namespace ecs
 {
 
-ComponentsTupleCache::ComponentsTupleCache(ComponentTypeId* componentTypesList, const std::size_t componentTypesCount)
-	: m_componentsCount(componentTypesCount)
+ComponentsTupleCache::ComponentsTupleCache(ComponentTypeId* componentTypesList, const std::size_t componentTypesCount, std::pmr::memory_resource* resource)
+	: m_componentTuples(resource)
+	, m_componentsCount(componentTypesCount)
 {
 	if (componentTypesCount > 0)
 	{
 		m_componentTypesList = new ComponentTypeId[componentTypesCount];
 		std::memcpy(m_componentTypesList, componentTypesList, sizeof(ComponentTypeId) * componentTypesCount);
 	}
+
+	for (std::size_t i = 0U; i < componentTypesCount; ++i)
+	{
+		m_componentsMask.set(componentTypesList[i]);
+	}
 }
 
 ComponentsTupleCache::~ComponentsTupleCache()
@@ -29,6 +36,7 @@ ComponentsTupleCache::ComponentsTupleCache(ComponentsTupleCache&& other)
 	: m_componentTuples(std::move(other.m_componentTuples))
 	, m_componentsCount(other.m_componentsCount)
 	, m_componentTypesList(other.m_componentTypesList)
+	, m_componentsMask(other.m_componentsMask)
 {
 	other.m_componentTypesList = nullptr;
 	other.m_componentsCount = 0;
@@ -39,6 +47,7 @@ ComponentsTupleCache& ComponentsTupleCache::operator=(ComponentsTupleCache&& oth
 	m_componentTuples = std::move(other.m_componentTuples);
 	m_componentsCount = other.m_componentsCount;
 	m_componentTypesList = other.m_componentTypesList;
+	m_componentsMask = other.m_componentsMask;
 
 	other.m_componentTypesList = nullptr;
 	other.m_componentsCount = 0;
@@ -46,7 +55,7 @@ ComponentsTupleCache& ComponentsTupleCache::operator=(ComponentsTupleCache&& oth
 	return *this;
 }
 
-std::unordered_map<EntityId, ComponentsTuple>& ComponentsTupleCache::GetData()
+ComponentsTupleCache::TuplesMap& ComponentsTupleCache::GetData()
 {
 	return m_componentTuples;
 }
@@ -66,15 +75,7 @@ void ComponentsTupleCache::TouchEntity(const EntityId entityId)
 	else
 	{
 		// Check if given entity has all component to be in tuple
-		bool hasAllComponents = true;
-		for (std::size_t i = 0U; i < m_componentsCount; i++)
-		{
-			if (!entityData->componentsMask.test(m_componentTypesList[i]))
-			{
-				hasAllComponents = false;
-				break;
-			}
-		}
+		const bool hasAllComponents = entityData->componentsMask.Contains(m_componentsMask);
 
 		// Handle add/remove from tuple cache
 		auto it = m_componentTuples.find(entityId);
@@ -82,25 +83,7 @@ void ComponentsTupleCache::TouchEntity(const EntityId entityId)
 		{
 			if (it == m_componentTuples.end())
 			{
-				// Fill components tuple
-				ComponentsTuple componentsTuple(m_componentsCount);
-
-				for (std::size_t i = 0; i < m_componentsCount; i++)
-				{
-					ComponentTypeId typeId = m_componentTypesList[i];
-					auto it = std::find_if(entityData->components.begin(), entityData->components.end(), [typeId](const ComponentPtr& component) {
-						return component.GetTypeId() == typeId;
-					});
-					
-					if (it != entityData->components.end())
-					{
-						componentsTuple[i] = *it;
-					}
-				}
-				//entity.GetComponentsOfTypes(componentsTuple.GetMutableData(), m_componentTypesList, m_componentsCount);
-
-				// Add to cache
-				m_componentTuples.emplace(entityId, std::move(componentsTuple));
+				AddEntityTuple(*entityData);
 			}
 		}
 		else
@@ -114,4 +97,38 @@ void ComponentsTupleCache::TouchEntity(const EntityId entityId)
 	}
 }
 
+void ComponentsTupleCache::AddEntities(const EntityId* entityIds, const std::size_t count)
+{
+	m_componentTuples.reserve(m_componentTuples.size() + count);
+
+	EntitiesCollection& entitiesCollection = Manager::Get()->GetEntitiesCollection();
+	for (std::size_t i = 0U; i < count; ++i)
+	{
+		EntityData* entityData = entitiesCollection.GetEntityData(entityIds[i]);
+		assert(nullptr != entityData && entityData->componentsMask.Contains(m_componentsMask));
+
+		AddEntityTuple(*entityData);
+	}
+}
+
+void ComponentsTupleCache::AddEntityTuple(const EntityData& entityData)
+{
+	// Fill components tuple
+	ComponentsTuple componentsTuple(m_componentsCount, m_componentTuples.get_allocator().resource());
+	const ComponentMaskType& tagTypesMask = Manager::Get()->GetTagTypesMask();
+
+	for (std::size_t i = 0; i < m_componentsCount; i++)
+	{
+		// Tags have no components, their tuple entries stay empty
+		const ComponentPtr* component = entityData.FindComponent(m_componentTypesList[i], tagTypesMask);
+		if (nullptr != component)
+		{
+			componentsTuple[i] = ComponentHandle(*component);
+		}
+	}
+
+	// Add to cache
+	m_componentTuples.emplace(entityData.id, std::move(componentsTuple));
+}
+
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include <memory_resource>
 #include <unordered_map>
 #include "ecs/detail/Types.hpp"
 #include "ecs/component/ComponentPtr.hpp"
@@ -7,11 +8,16 @@
 namespace ecs
 {
 
+struct EntityData;
+
 class ComponentsTupleCache
 {
 public:
+	using TuplesMap = std::pmr::unordered_map<EntityId, ComponentsTuple>;
+
 	ComponentsTupleCache() = delete;
-	ECS_API ComponentsTupleCache(ComponentTypeId* componentTypesList, const std::size_t componentTypesCount);
+	// Cached tuples are allocated from provided memory resource
+	ECS_API ComponentsTupleCache(ComponentTypeId* componentTypesList, const std::size_t componentTypesCount, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 	ECS_API ~ComponentsTupleCache();
 
 	ComponentsTupleCache(const ComponentsTupleCache&) = delete;
@@ -21,15 +27,28 @@ public:
 	ECS_API ComponentsTupleCache(ComponentsTupleCache&& other);
 	ECS_API ComponentsTupleCache& operator=(ComponentsTupleCache&& other);
 
-	ECS_API std::unordered_map<EntityId, ComponentsTuple>& GetData();
+	ECS_API TuplesMap& GetData();
 
 	// Touch entity to see if its components match the cache definition, modifying m_componentTuples map
 	void ECS_API TouchEntity(const EntityId entityId);
 
+	// Adds new entities, which aren't cached yet and have all the cache components (used by batch instantiation)
+	void ECS_API AddEntities(const EntityId* entityIds, const std::size_t count);
+
+	const ComponentMaskType& GetComponentsMask() const
+	{
+		return m_componentsMask;
+	}
+
+private:
+	// Fills components tuple of the entity, which has all the cache components, and adds it to the cache
+	void AddEntityTuple(const EntityData& entityData);
+
 private:
-	std::unordered_map<EntityId, ComponentsTuple> m_componentTuples;
+	TuplesMap m_componentTuples;
 	ComponentTypeId* m_componentTypesList;
 	std::size_t m_componentsCount;
+	ComponentMaskType m_componentsMask; // Entity must contain the mask to be in the cache
 };
 
 }
@@ -12,7 +12,7 @@ public:
 		: m_cache(inCache)
 	{}
 
-	using CollectionT = std::unordered_map<EntityId, ComponentsTuple>;
+	using CollectionT = ComponentsTupleCache::TuplesMap;
 
 	// Collection iterator implementation
 	struct iterator
@@ -13,8 +13,8 @@ public:
 		: m_cache(inCache)
 	{}
 
-	using CollectionT = std::unordered_map<EntityId, ComponentsTuple>;
-	using StdComponentsTupleT = std::tuple<TComponentPtr<ComponentTypes>...>;
+	using CollectionT = ComponentsTupleCache::TuplesMap;
+	using StdComponentsTupleT = ComponentHandlesTupleT<ComponentTypes...>;
 
 	// Collection iterator implementation
 	struct iterator
@@ -31,9 +31,8 @@ public:
 
 		value_type operator*()
 		{
-			ComponentsTuple& cachedTuple = internalIterator->second;
-			StdComponentsTupleT outTuple = cachedTuple.GetTyped<ComponentTypes...>();
-			return outTuple;
+			const ComponentsTuple& cachedTuple = internalIterator->second;
+			return cachedTuple.GetTypedHandles<ComponentTypes...>();
 		}
 
 		pointer operator->()
@@ -66,7 +65,7 @@ public:
 		TComponentPtr<T> ConvertToTypedPtr(const std::size_t i)
 		{
 			const ComponentsTuple& cachedTuple = internalIterator->second;
-			return TComponentPtr<T>(cachedTuple[i]);
+			return TComponentPtr<T>(cachedTuple[i].ToPtr());
 		}
 
 		CollectionT::iterator internalIterator;
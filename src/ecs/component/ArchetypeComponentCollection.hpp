@@ -0,0 +1,234 @@
+#pragma once
+#include "IComponentCollection.hpp"
+#include "ecs/storage/ArchetypeStorage.hpp"
+#include "ecs/storage/ObjectPool.hpp"
+#include "ecs/entity/Entity.hpp"
+#include "ecs/detail/Construct.hpp"
+
+#include <cassert>
+
+namespace ecs
+{
+
+/**
+* @brief Component collection, which keeps components in the manager archetype storage.
+*
+* Components of the entity, stored in archetype collections, are placed into the same archetype chunk row,
+* so systems working with several such components iterate chunks linearly (see Manager::ForEachArchetypeChunk).
+* Collection itself keeps only control blocks, control block data index is the handle slot in archetype storage,
+* so handles stay valid while component moves between archetypes. Entity may own a single component of each archetype stored type.
+*/
+template <typename ComponentType>
+class ArchetypeComponentCollection
+	: public IComponentCollection
+{
+	using CollectionType = ArchetypeComponentCollection<ComponentType>;
+
+public:
+	ArchetypeComponentCollection(ComponentTypeId typeId, const AllocationPolicy& policy = AllocationPolicy())
+		: IComponentCollection(detail::GetMemoryResource(policy))
+		, m_controlBlocks(policy)
+		, m_typeId(typeId)
+	{}
+	~ArchetypeComponentCollection() = default;
+
+	// Storage is assigned by manager during component type registration
+	void SetStorage(ArchetypeStorage* storage)
+	{
+		m_storage = storage;
+		m_storage->RegisterComponentType(m_typeId, ArchetypeColumnType::Create<ComponentType>());
+	}
+
+	void Clear() final
+	{
+		for (std::size_t index = m_controlBlocks.GetNextObjectIndex(0U); index != m_controlBlocks.GetInvalidPoolId(); index = m_controlBlocks.GetNextObjectIndex(index + 1U))
+		{
+			m_storage->DestroyComponent(m_typeId, static_cast<int32_t>(index));
+		}
+
+		m_handles.UnregisterAll();
+		m_controlBlocks.Clear();
+	}
+
+	// Archetype chunks are released by manager, compacting archetype storage
+	void Compact() override
+	{
+		m_controlBlocks.ReleaseEmptyRooms();
+	}
+
+	// Disable collection copy
+	ArchetypeComponentCollection(const ArchetypeComponentCollection&) = delete;
+	ArchetypeComponentCollection& operator=(const ArchetypeComponentCollection&) = delete;
+
+	// Collection iterator implementation
+	struct iterator
+	{
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = TComponentHandle<ComponentType>;
+		using pointer = TComponentHandle<ComponentType>*;
+		using reference = TComponentHandle<ComponentType>&;
+
+		iterator() = default;
+		iterator(CollectionType* collection, int32_t index)
+			: collection(collection)
+			, index(index)
+		{}
+
+		value_type operator*()
+		{
+			return value_type(collection->m_controlBlocks.At(index));
+		}
+
+		iterator& operator++()
+		{
+			index = collection->GetNextIndex(index);
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			const auto temp(*this); ++*this; return temp;
+		}
+
+		bool operator==(const iterator& other) const
+		{
+			return index == other.index;
+		}
+
+		bool operator!=(const iterator& other) const
+		{
+			return !(*this == other);
+		}
+
+		CollectionType* collection;
+		int32_t index;
+	};
+
+	ComponentPtr Create() override
+	{
+		return Emplace();
+	}
+
+	// Creates detached component in the staging storage, using provided constructor arguments
+	template <typename ...Args>
+	TComponentPtr<ComponentType> Emplace(Args&&... args)
+	{
+		assert(nullptr != m_storage);
+
+		auto blockInsertResult = m_controlBlocks.Emplace(m_typeId, -1, Entity::GetInvalidId(), 1);
+		const int32_t handleSlot = static_cast<int32_t>(blockInsertResult.index);
+		blockInsertResult.ref.dataIndex = handleSlot;
+		m_handles.Register(blockInsertResult.ref);
+
+		detail::ConstructAt<ComponentType>(m_storage->StageComponent(m_typeId, handleSlot), std::forward<Args>(args)...);
+
+		return TComponentPtr<ComponentType>(&blockInsertResult.ref);
+	}
+
+	void CreateComponents(const std::size_t count, ComponentPtr* outComponents) override
+	{
+		EmplaceComponents(count, outComponents);
+	}
+
+	void CreateComponents(const std::size_t count, TComponentPtr<ComponentType>* outComponents)
+	{
+		EmplaceComponents(count, outComponents);
+	}
+
+	void Destroy(const std::size_t index) override
+	{
+		m_storage->DestroyComponent(m_typeId, static_cast<int32_t>(index));
+		m_handles.Unregister(m_controlBlocks.At(index));
+		m_controlBlocks.RemoveAt(index);
+	}
+
+	void* GetData(const std::size_t index) override
+	{
+		return m_storage->GetComponentData(m_typeId, static_cast<int32_t>(index));
+	}
+
+	ComponentPtrBlock* GetControlBlock(const std::size_t index) override
+	{
+		return &m_controlBlocks.At(index);
+	}
+
+	ComponentPtr GetItemPtr(const std::size_t index) override
+	{
+		return GetTypedItemPtr(index);
+	}
+
+	TComponentPtr<ComponentType> GetTypedItemPtr(const std::size_t index)
+	{
+		ComponentPtrBlock* controlBlock = GetControlBlock(index);
+		if (nullptr != controlBlock && controlBlock->refCount > 0)
+		{
+			++controlBlock->refCount;
+		}
+
+		return TComponentPtr<ComponentType>(controlBlock);
+	}
+
+	int32_t GetNextIndex(int32_t currentIndex)
+	{
+		std::size_t nextIndex = m_controlBlocks.GetNextObjectIndex(static_cast<std::size_t>(currentIndex + 1));
+		return (nextIndex == m_controlBlocks.GetInvalidPoolId()) ? -1 : static_cast<int32_t>(nextIndex);
+	}
+
+	void CopyData(const std::size_t index, const void* dataSource) override
+	{
+		*static_cast<ComponentType*>(GetData(index)) = *reinterpret_cast<const ComponentType*>(dataSource);
+	}
+
+	void MoveData(const std::size_t index, void* dataSource) override
+	{
+		*static_cast<ComponentType*>(GetData(index)) = std::move(*reinterpret_cast<ComponentType*>(dataSource));
+	}
+
+	ComponentPtr CloneComponent(const std::size_t index) override
+	{
+		// Chunks never move, so source reference survives staging row allocation
+		const ComponentType& source = *static_cast<const ComponentType*>(GetData(index));
+		return Emplace(source);
+	}
+
+	void OnComponentEntityChanged(const std::size_t index, const EntityId entityId) override
+	{
+		if (Entity::GetInvalidId() != entityId)
+		{
+			m_storage->AttachComponent(m_typeId, static_cast<int32_t>(index), entityId);
+		}
+		else
+		{
+			m_storage->DetachComponent(m_typeId, static_cast<int32_t>(index));
+		}
+	}
+
+	iterator begin()
+	{
+		return iterator(this, GetNextIndex(-1));
+	}
+
+	iterator end()
+	{
+		return iterator(this, -1);
+	}
+
+private:
+	template <typename PtrType>
+	void EmplaceComponents(const std::size_t count, PtrType* outComponents)
+	{
+		m_controlBlocks.Reserve(count);
+
+		for (std::size_t i = 0U; i < count; ++i)
+		{
+			outComponents[i] = Emplace();
+		}
+	}
+
+private:
+	ObjectPool<ComponentPtrBlock> m_controlBlocks;
+	ArchetypeStorage* m_storage = nullptr;
+	ComponentTypeId m_typeId;
+};
+
+} // namespace ecs
@@ -0,0 +1,38 @@
+#pragma once
+#include "ecs/storage/DenseSlotTable.hpp"
+
+namespace ecs
+{
+
+/**
+* @brief Reorders two dense collections (dense or SoA), so that components of entities, present in both collections,
+* are placed at the beginning of both collections in the same order.
+*
+* After the call, for every slot index below returned count, components at this slot in both collections belong to the same entity,
+* so the collections can be processed by a single linear loop. Call is cheap when the collections are already aligned (no swaps happen).
+* @return Count of aligned slots
+*/
+template <typename LeftCollectionT, typename RightCollectionT>
+std::size_t AlignCollections(LeftCollectionT& left, RightCollectionT& right)
+{
+	const DenseSlotTable& leftSlots = left.GetSlotTable();
+	const DenseSlotTable& rightSlots = right.GetSlotTable();
+
+	std::size_t alignedCount = 0U;
+	const std::size_t leftSize = leftSlots.GetSize();
+	for (std::size_t i = 0U; i < leftSize; ++i)
+	{
+		const SparseIndex::IndexType rightIndex = rightSlots.FindByEntity(leftSlots.GetEntitiesData()[i]);
+		if (SparseIndex::GetInvalidIndex() != rightIndex)
+		{
+			// All slots below aligned count are already matched, so swapped items are never aligned ones
+			left.SwapSlots(i, alignedCount);
+			right.SwapSlots(static_cast<std::size_t>(rightIndex), alignedCount);
+			++alignedCount;
+		}
+	}
+
+	return alignedCount;
+}
+
+} // namespace ecs
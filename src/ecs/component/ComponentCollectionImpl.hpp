@@ -1,15 +1,21 @@
 #pragma once
 #include "IComponentCollection.hpp"
+#include "ecs/component/ComponentStorageTraits.hpp"
 #include "ecs/storage/MemoryPool.hpp"
 #include "ecs/storage/ObjectPool.hpp"
 #include "ecs/entity/Entity.hpp"
+#include "ecs/detail/Construct.hpp"
 
 #include <cassert>
 
 namespace ecs
 {
 
-template <typename ComponentType>
+/**
+* @brief Default component collection, which keeps components in a paged object pool.
+* Room size sets the allocation granularity, small rooms suit rare types and big rooms suit types with many instances.
+*/
+template <typename ComponentType, std::size_t RoomSize>
 class ComponentCollectionImpl
 	: public IComponentCollection
 {
@@ -18,19 +24,31 @@ class ComponentCollectionImpl
 		ComponentType component;
 		ComponentPtrBlock controlBlock;
 
-		ComponentData() = default;
+		// Component is constructed in place from forwarded arguments, data index is assigned after insertion
+		template <typename ...Args>
+		ComponentData(const ComponentTypeId typeId, Args&&... args)
+			: component(detail::MakeObject<ComponentType>(std::forward<Args>(args)...))
+			, controlBlock(typeId, -1, Entity::GetInvalidId(), 1)
+		{
+			// Rooms never move, so component address is cached once
+			controlBlock.data = &component;
+		}
 	};
 	
-	using CollectionType = ComponentCollectionImpl<ComponentType>;
+	using CollectionType = ComponentCollectionImpl<ComponentType, RoomSize>;
+	using PoolType = ObjectPool<ComponentData, RoomSize>;
 
 public:
-	ComponentCollectionImpl(ComponentTypeId typeId)
-		: m_typeId(typeId)
+	ComponentCollectionImpl(ComponentTypeId typeId, const AllocationPolicy& policy = AllocationPolicy())
+		: IComponentCollection(detail::GetMemoryResource(policy))
+		, m_data(policy)
+		, m_typeId(typeId)
 	{}
 	~ComponentCollectionImpl() = default;
 
 	void Clear() final
 	{
+		m_handles.UnregisterAll();
 		m_data.Clear();
 	}
 
@@ -42,9 +60,9 @@ public:
 	struct iterator
 	{
 		using iterator_category = std::forward_iterator_tag;
-		using value_type = TComponentPtr<ComponentType>;
-		using pointer = TComponentPtr<ComponentType>*;
-		using reference = TComponentPtr<ComponentType>&;
+		using value_type = TComponentHandle<ComponentType>;
+		using pointer = TComponentHandle<ComponentType>*;
+		using reference = TComponentHandle<ComponentType>&;
 
 		iterator() = default;
 		iterator(CollectionType* collection, int32_t index)
@@ -54,12 +72,7 @@ public:
 
 		value_type operator*()
 		{
-			return collection->GetTypedItemPtr(index);
-		}
-
-		pointer operator->()
-		{
-			return &**this;
+			return value_type(collection->m_data.At(index).controlBlock);
 		}
 
 		iterator& operator++()
@@ -89,15 +102,33 @@ public:
 
 	ComponentPtr Create() override
 	{
-		// Create data using default constructor
-		auto insertResult = m_data.Emplace();
-		insertResult.ref.controlBlock = ComponentPtrBlock(m_typeId, static_cast<int32_t>(insertResult.index), Entity::GetInvalidId(), 1);
+		return Emplace();
+	}
+
+	// Creates component directly in its storage slot, using provided constructor arguments
+	template <typename ...Args>
+	TComponentPtr<ComponentType> Emplace(Args&&... args)
+	{
+		auto insertResult = m_data.Emplace(m_typeId, std::forward<Args>(args)...);
+		insertResult.ref.controlBlock.dataIndex = static_cast<int32_t>(insertResult.index);
+		m_handles.Register(insertResult.ref.controlBlock);
+
+		return TComponentPtr<ComponentType>(&insertResult.ref.controlBlock);
+	}
+
+	void CreateComponents(const std::size_t count, ComponentPtr* outComponents) override
+	{
+		EmplaceComponents(count, outComponents);
+	}
 
-		return ComponentPtr(&insertResult.ref.controlBlock);
+	void CreateComponents(const std::size_t count, TComponentPtr<ComponentType>* outComponents)
+	{
+		EmplaceComponents(count, outComponents);
 	}
 
 	void Destroy(const std::size_t index) override
 	{
+		m_handles.Unregister(m_data.At(index).controlBlock);
 		m_data.RemoveAt(index);
 	}
 
@@ -157,15 +188,21 @@ public:
 
 	ComponentPtr CloneComponent(const std::size_t index) override
 	{
-		// Create data using default constructor
-		auto insertResult = m_data.Emplace();
-		insertResult.ref.controlBlock = ComponentPtrBlock(m_typeId, static_cast<int32_t>(insertResult.index), Entity::GetInvalidId(), 1);
+		// Copy data using copy constructor, room addresses are stable so source reference survives insertion
+		const ComponentData& dataToClone = m_data.At(index);
+		return Emplace(dataToClone.component);
+	}
 
-		// Copy data using copy constructor
-		ComponentData& dataToClone = m_data.At(index);
-		insertResult.ref.component = ComponentType(dataToClone.component);
+	void CloneComponents(const std::size_t index, const std::size_t count, ComponentPtr* outComponents) override
+	{
+		// Copies fill reserved rooms contiguously, source room doesn't move
+		EmplaceComponents(count, outComponents, m_data.At(index).component);
+	}
 
-		return ComponentPtr(&insertResult.ref.controlBlock);
+	void Compact() override
+	{
+		// Control blocks are embedded into rooms, and handles point to them, so components never move and only empty rooms are released
+		m_data.ReleaseEmptyRooms();
 	}
 
 	iterator begin()
@@ -179,7 +216,24 @@ public:
 	}
 
 private:
-	ObjectPool<ComponentData> m_data;
+	// Reserves rooms once, and fills them contiguously with components, constructed from the same arguments
+	template <typename PtrType, typename ...Args>
+	void EmplaceComponents(const std::size_t count, PtrType* outComponents, const Args&... args)
+	{
+		m_data.Reserve(count);
+
+		std::size_t createdCount = 0U;
+		auto onInserted = [this, outComponents, &createdCount](const typename PoolType::InsertResult& insertResult)
+		{
+			insertResult.ref.controlBlock.dataIndex = static_cast<int32_t>(insertResult.index);
+			m_handles.Register(insertResult.ref.controlBlock);
+			outComponents[createdCount++] = PtrType(&insertResult.ref.controlBlock);
+		};
+		m_data.EmplaceMany(count, onInserted, m_typeId, args...);
+	}
+
+private:
+	PoolType m_data;
 	ComponentTypeId m_typeId;
 };
 
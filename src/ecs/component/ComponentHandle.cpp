@@ -0,0 +1,61 @@
+#include "ecs/component/ComponentHandle.hpp"
+#include "ecs/Manager.hpp"
+
+namespace ecs
+{
+
+ComponentPtrBlock* ComponentHandle::GetControlBlock() const
+{
+	if (IsNull())
+		return nullptr;
+
+	return Manager::Get()->GetCollection(typeId)->ResolveHandle(index, generation);
+}
+
+void* ComponentHandle::ResolveRawFromCollection(const ComponentPtrBlock& block)
+{
+	return Manager::Get()->GetComponentRaw(block.typeId, block.dataIndex);
+}
+
+ComponentTypeId ComponentHandle::TypeSequenceToTypeId(const uint32_t sequenceIndex)
+{
+	return Manager::Get()->GetComponentTypeIdBySequence(sequenceIndex);
+}
+
+ComponentPtr ComponentHandle::ToPtr() const
+{
+	ComponentPtrBlock* block = GetControlBlock();
+	if (nullptr != block && block->refCount > 0)
+	{
+		++block->refCount;
+		return ComponentPtr(block);
+	}
+
+	return ComponentPtr();
+}
+
+Entity ComponentHandle::GetEntity() const
+{
+	ComponentPtrBlock* block = GetControlBlock();
+	if (nullptr != block)
+	{
+		return Manager::Get()->GetEntityById(block->entityId);
+	}
+
+	return Entity();
+}
+
+ComponentHandle ComponentHandle::GetSibling(const ComponentTypeId componentType) const
+{
+	ComponentPtrBlock* block = GetControlBlock();
+	if (nullptr == block || Manager::GetInvalidComponentTypeId() == componentType)
+		return ComponentHandle();
+
+	// Entity components are scanned directly, so lookup doesn't touch reference counters
+	EntityData* entityData = Manager::Get()->GetEntitiesCollection().GetEntityData(block->entityId);
+	const ComponentPtr* component = (nullptr != entityData) ? entityData->FindComponent(componentType, Manager::Get()->GetTagTypesMask()) : nullptr;
+
+	return (nullptr != component) ? ComponentHandle(*component->m_block) : ComponentHandle();
+}
+
+} // namespace ecs
@@ -0,0 +1,128 @@
+#pragma once
+#include "raven_ecs_export.h"
+#include "ecs/detail/Types.hpp"
+#include "ecs/component/ComponentPtr.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <typeindex>
+
+namespace ecs
+{
+
+/**
+* @brief Lightweight component handle: handle table slot, slot generation and component type.
+*
+* Unlike ComponentPtr, handle is trivially copyable, and doesn't touch reference counters, so it doesn't keep
+* the component alive. Handle of destroyed component is stale, and resolves to nullptr.
+* Use ToPtr to get reference counting pointer for the component, that must be kept alive.
+*/
+struct ECS_API ComponentHandle
+{
+	static constexpr uint32_t k_invalidIndex = std::numeric_limits<uint32_t>::max();
+	static constexpr uint16_t k_invalidTypeId = std::numeric_limits<uint16_t>::max();
+
+	uint32_t index = k_invalidIndex;
+	uint16_t generation = 0U;
+	uint16_t typeId = k_invalidTypeId;
+
+	ComponentHandle() = default;
+
+	explicit ComponentHandle(const ComponentPtrBlock& block)
+		: index(block.handleIndex)
+		, generation(block.handleGeneration)
+		, typeId(static_cast<uint16_t>(block.typeId))
+	{}
+
+	explicit ComponentHandle(const ComponentPtr& componentPtr)
+	{
+		if (componentPtr.IsValid())
+		{
+			*this = ComponentHandle(*componentPtr.m_block);
+		}
+	}
+
+	bool IsNull() const
+	{
+		return k_invalidIndex == index;
+	}
+
+	// Returns control block of the component, or nullptr if handle is null or stale
+	ComponentPtrBlock* GetControlBlock() const;
+
+	// Returns component data, or nullptr if handle is null or stale
+	void* ResolveRaw() const
+	{
+		ComponentPtrBlock* block = GetControlBlock();
+		if (nullptr == block)
+			return nullptr;
+
+		return (nullptr != block->data) ? block->data : ResolveRawFromCollection(*block);
+	}
+
+	ComponentPtr ToPtr() const;
+	Entity GetEntity() const;
+
+	// Returns handle of the same entity component of another type, or null handle
+	ComponentHandle GetSibling(const ComponentTypeId componentType) const;
+
+	bool operator==(const ComponentHandle& other) const
+	{
+		return index == other.index && generation == other.generation && typeId == other.typeId;
+	}
+
+	bool operator!=(const ComponentHandle& other) const
+	{
+		return !(*this == other);
+	}
+
+private:
+	static void* ResolveRawFromCollection(const ComponentPtrBlock& block);
+	static ComponentTypeId TypeSequenceToTypeId(const uint32_t sequenceIndex);
+
+	template <class T>
+	friend struct TComponentHandle;
+};
+
+template <class T>
+struct TComponentHandle
+	: public ComponentHandle
+{
+	TComponentHandle() = default;
+
+	explicit TComponentHandle(const ComponentHandle& handle)
+		: ComponentHandle(handle)
+	{}
+
+	explicit TComponentHandle(const ComponentPtrBlock& block)
+		: ComponentHandle(block)
+	{}
+
+	// Checked resolution, returns nullptr if component has been destroyed
+	T* Resolve() const
+	{
+		return static_cast<T*>(ResolveRaw());
+	}
+
+	T* operator->() const
+	{
+		return Resolve();
+	}
+
+	TComponentPtr<T> ToPtr() const
+	{
+		return TComponentPtr<T>(ComponentHandle::ToPtr());
+	}
+
+	template <typename SiblingT>
+	TComponentHandle<SiblingT> GetSibling() const
+	{
+		return TComponentHandle<SiblingT>(ComponentHandle::GetSibling(TypeSequenceToTypeId(detail::TypeSequenceIndex<detail::TypeFamily::Component, SiblingT>())));
+	}
+};
+
+static_assert(sizeof(ComponentHandle) == 8U, "Component handle must fit 8 bytes");
+static_assert(std::is_trivially_copyable<ComponentHandle>::value, "Component handle must be trivially copyable");
+
+} // namespace ecs
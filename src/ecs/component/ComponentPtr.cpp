@@ -9,6 +9,9 @@ ComponentPtrBlock::ComponentPtrBlock()
 	, dataIndex(-1)
 	, entityId(Entity::GetInvalidId())
 	, refCount(0)
+	, data(nullptr)
+	, handleIndex(0U)
+	, handleGeneration(0U)
 {}
 
 ComponentPtrBlock::ComponentPtrBlock(ComponentTypeId inTypeId, int32_t inDataIndex, EntityId inEntityId, int32_t inRefCount)
@@ -16,6 +19,9 @@ ComponentPtrBlock::ComponentPtrBlock(ComponentTypeId inTypeId, int32_t inDataInd
 	, dataIndex(inDataIndex)
 	, entityId(inEntityId)
 	, refCount(inRefCount)
+	, data(nullptr)
+	, handleIndex(0U)
+	, handleGeneration(0U)
 {}
 
 ComponentPtr::ComponentPtr(ComponentPtrBlock* cblock)
@@ -33,6 +39,10 @@ ComponentPtr::ComponentPtr(const ComponentPtr& other)
 
 ComponentPtr& ComponentPtr::operator=(const ComponentPtr& other)
 {
+	if (this == &other)
+		return *this;
+
+	Reset();
 	m_block = other.m_block;
 
 	if (nullptr != m_block)
@@ -51,6 +61,10 @@ ComponentPtr::ComponentPtr(ComponentPtr&& other)
 
 ComponentPtr& ComponentPtr::operator=(ComponentPtr&& other)
 {
+	if (this == &other)
+		return *this;
+
+	Reset();
 	m_block = other.m_block;
 	other.m_block = nullptr;
 
@@ -65,9 +79,17 @@ ComponentPtr::~ComponentPtr()
 void ComponentPtr::Reset()
 {
 	Manager* manager = Manager::Get();
-	if (nullptr != manager && nullptr != m_block && m_block->refCount == 1U)
+	if (nullptr != manager && nullptr != m_block)
 	{
-		manager->ReleaseComponent(m_block->typeId, m_block->dataIndex);
+		// The last reference destroys the component, others just drop their reference
+		if (m_block->refCount == 1U)
+		{
+			manager->ReleaseComponent(m_block->typeId, m_block->dataIndex);
+		}
+		else if (m_block->refCount > 1)
+		{
+			--m_block->refCount;
+		}
 	}
 
 	m_block = nullptr;
@@ -98,7 +120,7 @@ Entity ComponentPtr::GetEntity() const
 	return Entity();
 }
 
-void* ComponentPtr::GetRawData() const
+void* ComponentPtr::ResolveRawData() const
 {
 	return Manager::Get()->GetComponentRaw(m_block->typeId, m_block->dataIndex);
 }
@@ -108,6 +130,11 @@ ComponentTypeId ComponentPtr::TypeIndexToTypeId(const std::type_index& typeIndex
 	return Manager::Get()->GetComponentTypeIdByIndex(typeIndex);
 }
 
+ComponentTypeId ComponentPtr::TypeSequenceToTypeId(const uint32_t sequenceIndex)
+{
+	return Manager::Get()->GetComponentTypeIdBySequence(sequenceIndex);
+}
+
 ComponentPtr ComponentPtr::GetSibling(const ComponentTypeId componentType) const
 {
 	return GetEntity().GetComponent(componentType);
@@ -1,6 +1,8 @@
 #pragma once
 #include "raven_ecs_export.h"
 #include "ecs/detail/Types.hpp"
+#include "ecs/detail/TypeSequence.hpp"
+#include "ecs/detail/Relocate.hpp"
 #include <cstdint>
 #include <typeindex>
 
@@ -19,6 +21,7 @@ class ECS_API ComponentPtr
 	friend class Manager;
 	friend struct Entity;
 	friend class EntitiesCollection;
+	friend struct ComponentHandle;
 
 public:
 	ComponentPtr() = default;
@@ -35,12 +38,18 @@ public:
 	bool IsValid() const;
 	void Reset();
 	ComponentPtr GetSibling(const ComponentTypeId componentType) const;
-	void* GetRawData() const;
+
+	// Cached address is a single load, collections without cached addresses are queried through the manager
+	void* GetRawData() const
+	{
+		void* data = m_block->data;
+		return (nullptr != data) ? data : ResolveRawData();
+	}
 
 	template <typename SiblingT>
 	TComponentPtr<SiblingT> GetSibling() const
 	{
-		return Cast<SiblingT>(GetSibling(TypeIndexToTypeId(typeid(SiblingT))));
+		return Cast<SiblingT>(GetSibling(TypeSequenceToTypeId(detail::TypeSequenceIndex<detail::TypeFamily::Component, SiblingT>())));
 	}
 
 	std::size_t GetHash() const;
@@ -50,6 +59,10 @@ public:
 	operator bool() const;
 
 	static ComponentTypeId TypeIndexToTypeId(const std::type_index& typeIndex);
+	static ComponentTypeId TypeSequenceToTypeId(const uint32_t sequenceIndex);
+
+private:
+	void* ResolveRawData() const;
 
 private:
 	ComponentPtrBlock* m_block = nullptr;
@@ -89,7 +102,7 @@ public:
 template <class T>
 TComponentPtr<T> Cast(const ComponentPtr& component)
 {
-	if (component.GetTypeId() == ComponentPtr::TypeIndexToTypeId(typeid(T)))
+	if (component.GetTypeId() == ComponentPtr::TypeSequenceToTypeId(detail::TypeSequenceIndex<detail::TypeFamily::Component, T>()))
 	{
 		return TComponentPtr<T>(component);
 	}
@@ -121,3 +134,6 @@ struct hash<ecs::TComponentPtr<T>>
 };
 
 }
+
+// Component ptr is a control block pointer, so containers move it with memcpy without touching reference counters
+ECS_TRIVIALLY_RELOCATABLE(ecs::ComponentPtr)
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+
+namespace ecs
+{
+
+template <typename ComponentType, std::size_t RoomSize = 32U>
+class ComponentCollectionImpl;
+
+template <typename ComponentType>
+class DenseComponentCollection;
+
+template <typename ComponentType>
+class SoAComponentCollection;
+
+template <typename ComponentType>
+class ArchetypeComponentCollection;
+
+template <typename ComponentType>
+class HashMapComponentCollection;
+
+/**
+* @brief Component storage customization point, which selects collection type used for component type.
+*
+* Paged object pool is used by default. Empty types have no storage, they are registered as tags (see
+* Manager::RegisterTagType), so traits aren't used for them. Specialize the traits
+* (or use ECS_COMPONENT_STORAGE / ECS_COMPONENT_PAGED_STORAGE macros) to select another backend:
+* dense array for hot types iterated linearly, hash map for rare types, or paged pool with custom room size.
+*/
+template <typename ComponentType>
+struct ComponentStorageTraits
+{
+	using CollectionType = ComponentCollectionImpl<ComponentType>;
+};
+
+template <typename ComponentType>
+using ComponentCollectionT = typename ComponentStorageTraits<ComponentType>::CollectionType;
+
+} // namespace ecs
+
+// Selects storage backend for component type, must be used in the global namespace
+#define ECS_COMPONENT_STORAGE(ComponentType, CollectionTemplate) \
+	namespace ecs { \
+	template <> \
+	struct ComponentStorageTraits<ComponentType> \
+	{ \
+		using CollectionType = CollectionTemplate<ComponentType>; \
+	}; \
+	}
+
+// Selects paged pool storage with RoomSize components per room, must be used in the global namespace
+#define ECS_COMPONENT_PAGED_STORAGE(ComponentType, RoomSize) \
+	namespace ecs { \
+	template <> \
+	struct ComponentStorageTraits<ComponentType> \
+	{ \
+		using CollectionType = ComponentCollectionImpl<ComponentType, RoomSize>; \
+	}; \
+	}
@@ -0,0 +1,314 @@
+#pragma once
+#include "IComponentCollection.hpp"
+#include "ecs/storage/DenseSlotTable.hpp"
+#include "ecs/entity/Entity.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace ecs
+{
+
+/**
+* @brief Component collection, which keeps components packed in a dense array (sparse set layout).
+*
+* Dense components array is parallel to the slots table, which keeps owning entity ids, control blocks,
+* and the sparse index mapping entity id to dense position. Component removal moves the last component
+* into the removed slot (swap and pop), patching its control block, so iteration is a linear scan
+* over contiguous memory. Control blocks live in a separate pool, so component handles stay valid
+* when components move. Cached component addresses of control blocks are patched for moved components,
+* and refreshed for all components when dense array is reallocated.
+*/
+template <typename ComponentType>
+class DenseComponentCollection
+	: public IComponentCollection
+{
+	using CollectionType = DenseComponentCollection<ComponentType>;
+
+public:
+	DenseComponentCollection(ComponentTypeId typeId, const AllocationPolicy& policy = AllocationPolicy())
+		: IComponentCollection(detail::GetMemoryResource(policy))
+		, m_components(detail::GetMemoryResource(policy))
+		, m_slots(policy)
+		, m_typeId(typeId)
+	{}
+	~DenseComponentCollection() = default;
+
+	void Clear() final
+	{
+		m_handles.UnregisterAll();
+		m_components.clear();
+		m_slots.Clear();
+	}
+
+	// Components are always packed, so compaction only releases unused capacity
+	void Compact() override
+	{
+		m_components.shrink_to_fit();
+		m_slots.Compact();
+		RefreshDataPointers();
+	}
+
+	// Disable collection copy
+	DenseComponentCollection(const DenseComponentCollection&) = delete;
+	DenseComponentCollection& operator=(const DenseComponentCollection&) = delete;
+
+	// Collection iterator implementation
+	struct iterator
+	{
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = TComponentHandle<ComponentType>;
+		using pointer = TComponentHandle<ComponentType>*;
+		using reference = TComponentHandle<ComponentType>&;
+
+		iterator() = default;
+		iterator(CollectionType* collection, int32_t index)
+			: collection(collection)
+			, index(index)
+		{}
+
+		value_type operator*()
+		{
+			return value_type(collection->m_slots.GetControlBlock(index));
+		}
+
+		iterator& operator++()
+		{
+			++index;
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			const auto temp(*this); ++*this; return temp;
+		}
+
+		bool operator==(const iterator& other) const
+		{
+			return index == other.index;
+		}
+
+		bool operator!=(const iterator& other) const
+		{
+			return !(*this == other);
+		}
+
+		CollectionType* collection;
+		int32_t index;
+	};
+
+	ComponentPtr Create() override
+	{
+		return Emplace();
+	}
+
+	// Creates component at the end of dense array, using provided constructor arguments
+	template <typename ...Args>
+	TComponentPtr<ComponentType> Emplace(Args&&... args)
+	{
+		const ComponentType* previousData = m_components.data();
+
+		if constexpr (std::is_constructible<ComponentType, Args...>::value)
+		{
+			m_components.emplace_back(std::forward<Args>(args)...);
+		}
+		else
+		{
+			m_components.push_back(ComponentType{ std::forward<Args>(args)... });
+		}
+
+		ComponentPtrBlock& controlBlock = m_slots.Push(m_typeId);
+		controlBlock.data = &m_components.back();
+		m_handles.Register(controlBlock);
+
+		if (m_components.data() != previousData)
+		{
+			RefreshDataPointers();
+		}
+
+		return TComponentPtr<ComponentType>(&controlBlock);
+	}
+
+	void CreateComponents(const std::size_t count, ComponentPtr* outComponents) override
+	{
+		EmplaceComponents(count, outComponents);
+	}
+
+	void CreateComponents(const std::size_t count, TComponentPtr<ComponentType>* outComponents)
+	{
+		EmplaceComponents(count, outComponents);
+	}
+
+	void DestroyComponents(const std::size_t* indexes, const std::size_t count) override
+	{
+		// Removal moves the last component, so components are removed starting from the highest index to keep indexes valid
+		std::pmr::vector<std::size_t> sortedIndexes(indexes, indexes + count, GetMemoryResource());
+		std::sort(sortedIndexes.begin(), sortedIndexes.end(), std::greater<std::size_t>());
+
+		for (const std::size_t index : sortedIndexes)
+		{
+			Destroy(index);
+		}
+	}
+
+	void Destroy(const std::size_t index) override
+	{
+		assert(index < m_components.size());
+		m_handles.Unregister(m_slots.GetControlBlock(index));
+
+		// Move last component into the removed slot, slots table patches moved component control block
+		const std::size_t lastIndex = m_components.size() - 1U;
+		if (index != lastIndex)
+		{
+			m_components[index] = std::move(m_components[lastIndex]);
+		}
+
+		m_components.pop_back();
+		m_slots.RemoveSwap(index);
+
+		if (index != lastIndex)
+		{
+			m_slots.GetControlBlock(index).data = &m_components[index];
+		}
+	}
+
+	void* GetData(const std::size_t index) override
+	{
+		return &m_components[index];
+	}
+
+	ComponentPtrBlock* GetControlBlock(const std::size_t index) override
+	{
+		return &m_slots.GetControlBlock(index);
+	}
+
+	ComponentPtr GetItemPtr(const std::size_t index) override
+	{
+		return GetTypedItemPtr(index);
+	}
+
+	TComponentPtr<ComponentType> GetTypedItemPtr(const std::size_t index)
+	{
+		ComponentPtrBlock* controlBlock = GetControlBlock(index);
+		if (nullptr != controlBlock && controlBlock->refCount > 0)
+		{
+			++controlBlock->refCount;
+		}
+
+		return TComponentPtr<ComponentType>(controlBlock);
+	}
+
+	void CopyData(const std::size_t index, const void* dataSource) override
+	{
+		m_components[index] = *reinterpret_cast<const ComponentType*>(dataSource);
+	}
+
+	void MoveData(const std::size_t index, void* dataSource) override
+	{
+		m_components[index] = std::move(*reinterpret_cast<ComponentType*>(dataSource));
+	}
+
+	ComponentPtr CloneComponent(const std::size_t index) override
+	{
+		// Copy source first, as dense array can be reallocated during insertion
+		ComponentType componentCopy(m_components[index]);
+		return Emplace(std::move(componentCopy));
+	}
+
+	void CloneComponents(const std::size_t index, const std::size_t count, ComponentPtr* outComponents) override
+	{
+		// Copy source first, as dense array is reallocated by reservation
+		const ComponentType componentCopy(m_components[index]);
+		EmplaceComponents(count, outComponents, componentCopy);
+	}
+
+	void OnComponentEntityChanged(const std::size_t index, const EntityId entityId) override
+	{
+		m_slots.SetEntity(index, entityId);
+	}
+
+	// Returns component attached to the entity, or nullptr if entity has no component of this type
+	ComponentType* GetByEntity(const EntityId entityId)
+	{
+		const SparseIndex::IndexType denseIndex = m_slots.FindByEntity(entityId);
+		return (SparseIndex::GetInvalidIndex() != denseIndex) ? &m_components[denseIndex] : nullptr;
+	}
+
+	// Dense data access for linear processing, arrays are parallel and contain GetSize() elements
+	ComponentType* GetComponentsData()
+	{
+		return m_components.data();
+	}
+
+	const EntityId* GetEntitiesData() const
+	{
+		return m_slots.GetEntitiesData();
+	}
+
+	// Swaps two components, keeping their handles valid (used for reordering)
+	void SwapSlots(const std::size_t leftIndex, const std::size_t rightIndex)
+	{
+		std::swap(m_components[leftIndex], m_components[rightIndex]);
+		m_slots.Swap(leftIndex, rightIndex);
+		m_slots.GetControlBlock(leftIndex).data = &m_components[leftIndex];
+		m_slots.GetControlBlock(rightIndex).data = &m_components[rightIndex];
+	}
+
+	const DenseSlotTable& GetSlotTable() const
+	{
+		return m_slots;
+	}
+
+	std::size_t GetSize() const
+	{
+		return m_components.size();
+	}
+
+	iterator begin()
+	{
+		return iterator(this, 0);
+	}
+
+	iterator end()
+	{
+		return iterator(this, static_cast<int32_t>(m_components.size()));
+	}
+
+private:
+	// Dense array has been reallocated, so cached addresses of all components are updated
+	void RefreshDataPointers()
+	{
+		for (std::size_t i = 0U; i < m_components.size(); ++i)
+		{
+			m_slots.GetControlBlock(i).data = &m_components[i];
+		}
+	}
+
+	template <typename PtrType, typename ...Args>
+	void EmplaceComponents(const std::size_t count, PtrType* outComponents, const Args&... args)
+	{
+		const ComponentType* previousData = m_components.data();
+		m_components.reserve(m_components.size() + count);
+		m_slots.Reserve(count);
+
+		if (m_components.data() != previousData)
+		{
+			RefreshDataPointers();
+		}
+
+		for (std::size_t i = 0U; i < count; ++i)
+		{
+			outComponents[i] = Emplace(args...);
+		}
+	}
+
+private:
+	std::pmr::vector<ComponentType> m_components;
+	DenseSlotTable m_slots;
+	ComponentTypeId m_typeId;
+};
+
+} // namespace ecs
@@ -0,0 +1,255 @@
+#pragma once
+#include "IComponentCollection.hpp"
+#include "ecs/component/ComponentStorageTraits.hpp"
+#include "ecs/storage/AllocationPolicy.hpp"
+#include "ecs/entity/Entity.hpp"
+#include "ecs/detail/Construct.hpp"
+
+#include <cassert>
+#include <iterator>
+#include <memory_resource>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ecs
+{
+
+/**
+* @brief Component collection for rare component types, which keeps every component in its own hash map node.
+*
+* Memory is spent per alive component only, so types with a few instances don't reserve whole pool rooms.
+* Map nodes never move, so control blocks are embedded into nodes like in paged pool collection.
+* Data index is the node key, keys of destroyed components are reused.
+*/
+template <typename ComponentType>
+class HashMapComponentCollection
+	: public IComponentCollection
+{
+	struct ComponentData
+	{
+		ComponentType component;
+		ComponentPtrBlock controlBlock;
+
+		template <typename ...Args>
+		ComponentData(const ComponentTypeId typeId, const int32_t dataIndex, Args&&... args)
+			: component(detail::MakeObject<ComponentType>(std::forward<Args>(args)...))
+			, controlBlock(typeId, dataIndex, Entity::GetInvalidId(), 1)
+		{
+			controlBlock.data = &component;
+		}
+	};
+
+	using MapType = std::pmr::unordered_map<int32_t, ComponentData>;
+
+public:
+	HashMapComponentCollection(ComponentTypeId typeId, const AllocationPolicy& policy = AllocationPolicy())
+		: IComponentCollection(detail::GetMemoryResource(policy))
+		, m_data(detail::GetMemoryResource(policy))
+		, m_freeIndexes(detail::GetMemoryResource(policy))
+		, m_typeId(typeId)
+	{}
+	~HashMapComponentCollection() = default;
+
+	void Clear() final
+	{
+		m_handles.UnregisterAll();
+		m_data.clear();
+		m_freeIndexes.clear();
+		m_nextIndex = 0;
+	}
+
+	// Nodes are freed on destruction, so compaction only shrinks buckets and free keys list
+	void Compact() override
+	{
+		if (m_data.empty())
+		{
+			m_freeIndexes.clear();
+			m_nextIndex = 0;
+		}
+
+		m_data.rehash(0U);
+		m_freeIndexes.shrink_to_fit();
+	}
+
+	// Disable collection copy
+	HashMapComponentCollection(const HashMapComponentCollection&) = delete;
+	HashMapComponentCollection& operator=(const HashMapComponentCollection&) = delete;
+
+	// Collection iterator implementation, components are visited in unspecified order
+	struct iterator
+	{
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = TComponentHandle<ComponentType>;
+		using pointer = TComponentHandle<ComponentType>*;
+		using reference = TComponentHandle<ComponentType>&;
+
+		iterator() = default;
+		iterator(typename MapType::iterator mapIterator)
+			: mapIterator(mapIterator)
+		{}
+
+		value_type operator*()
+		{
+			return value_type(mapIterator->second.controlBlock);
+		}
+
+		iterator& operator++()
+		{
+			++mapIterator;
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			const auto temp(*this); ++*this; return temp;
+		}
+
+		bool operator==(const iterator& other) const
+		{
+			return mapIterator == other.mapIterator;
+		}
+
+		bool operator!=(const iterator& other) const
+		{
+			return !(*this == other);
+		}
+
+		typename MapType::iterator mapIterator;
+	};
+
+	ComponentPtr Create() override
+	{
+		return Emplace();
+	}
+
+	// Creates component in a new map node, using provided constructor arguments
+	template <typename ...Args>
+	TComponentPtr<ComponentType> Emplace(Args&&... args)
+	{
+		int32_t dataIndex = m_nextIndex;
+		if (!m_freeIndexes.empty())
+		{
+			dataIndex = m_freeIndexes.back();
+			m_freeIndexes.pop_back();
+		}
+		else
+		{
+			++m_nextIndex;
+		}
+
+		auto insertResult = m_data.emplace(std::piecewise_construct, std::forward_as_tuple(dataIndex),
+			std::forward_as_tuple(m_typeId, dataIndex, std::forward<Args>(args)...));
+		assert(insertResult.second);
+		m_handles.Register(insertResult.first->second.controlBlock);
+
+		return TComponentPtr<ComponentType>(&insertResult.first->second.controlBlock);
+	}
+
+	void CreateComponents(const std::size_t count, ComponentPtr* outComponents) override
+	{
+		EmplaceComponents(count, outComponents);
+	}
+
+	void CreateComponents(const std::size_t count, TComponentPtr<ComponentType>* outComponents)
+	{
+		EmplaceComponents(count, outComponents);
+	}
+
+	void Destroy(const std::size_t index) override
+	{
+		m_handles.Unregister(GetComponentData(index).controlBlock);
+		const std::size_t erasedCount = m_data.erase(static_cast<int32_t>(index));
+		assert(1U == erasedCount);
+		(void)erasedCount;
+
+		m_freeIndexes.push_back(static_cast<int32_t>(index));
+	}
+
+	void* GetData(const std::size_t index) override
+	{
+		return &GetComponentData(index).component;
+	}
+
+	ComponentPtrBlock* GetControlBlock(const std::size_t index) override
+	{
+		return &GetComponentData(index).controlBlock;
+	}
+
+	ComponentPtr GetItemPtr(const std::size_t index) override
+	{
+		return GetTypedItemPtr(index);
+	}
+
+	TComponentPtr<ComponentType> GetTypedItemPtr(const std::size_t index)
+	{
+		ComponentPtrBlock* controlBlock = GetControlBlock(index);
+		if (nullptr != controlBlock && controlBlock->refCount > 0)
+		{
+			++controlBlock->refCount;
+		}
+
+		return TComponentPtr<ComponentType>(controlBlock);
+	}
+
+	void CopyData(const std::size_t index, const void* dataSource) override
+	{
+		GetComponentData(index).component = *reinterpret_cast<const ComponentType*>(dataSource);
+	}
+
+	void MoveData(const std::size_t index, void* dataSource) override
+	{
+		GetComponentData(index).component = std::move(*reinterpret_cast<ComponentType*>(dataSource));
+	}
+
+	ComponentPtr CloneComponent(const std::size_t index) override
+	{
+		// Nodes survive rehashing, so source reference stays valid during insertion
+		const ComponentType& source = GetComponentData(index).component;
+		return Emplace(source);
+	}
+
+	std::size_t GetSize() const
+	{
+		return m_data.size();
+	}
+
+	iterator begin()
+	{
+		return iterator(m_data.begin());
+	}
+
+	iterator end()
+	{
+		return iterator(m_data.end());
+	}
+
+private:
+	ComponentData& GetComponentData(const std::size_t index)
+	{
+		auto it = m_data.find(static_cast<int32_t>(index));
+		assert(it != m_data.end());
+
+		return it->second;
+	}
+
+	template <typename PtrType>
+	void EmplaceComponents(const std::size_t count, PtrType* outComponents)
+	{
+		m_data.reserve(m_data.size() + count);
+
+		for (std::size_t i = 0U; i < count; ++i)
+		{
+			outComponents[i] = Emplace();
+		}
+	}
+
+private:
+	MapType m_data;
+	std::pmr::vector<int32_t> m_freeIndexes;
+	int32_t m_nextIndex = 0;
+	ComponentTypeId m_typeId;
+};
+
+} // namespace ecs
@@ -1,6 +1,9 @@
 #pragma once
 #include "ecs/component/ComponentPtr.hpp"
+#include "ecs/component/ComponentHandle.hpp"
+#include "ecs/storage/ComponentHandleTable.hpp"
 #include <cstddef>
+#include <memory_resource>
 
 namespace ecs
 {
@@ -8,6 +11,10 @@ namespace ecs
 class IComponentCollection
 {
 public:
+	IComponentCollection() = default;
+	explicit IComponentCollection(std::pmr::memory_resource* resource)
+		: m_handles(resource)
+	{}
 	virtual ~IComponentCollection() = default;
 
 	virtual void Clear() = 0;
@@ -15,6 +22,22 @@ public:
 	virtual ComponentPtr Create() = 0;
 	// Destroy collection element by index. When destroy succeeds, component destructor is called.
 	virtual void Destroy(const std::size_t index) = 0;
+	// Creates count default constructed components, writing their handles to outComponents (which must contain empty handles)
+	virtual void CreateComponents(const std::size_t count, ComponentPtr* outComponents)
+	{
+		for (std::size_t i = 0U; i < count; ++i)
+		{
+			outComponents[i] = Create();
+		}
+	}
+	// Destroys components by indexes, collections which move components on destruction must handle indexes invalidation
+	virtual void DestroyComponents(const std::size_t* indexes, const std::size_t count)
+	{
+		for (std::size_t i = 0U; i < count; ++i)
+		{
+			Destroy(indexes[i]);
+		}
+	}
 	// Retreives pointer to collection item by index
 	virtual void* GetData(const std::size_t index) = 0;
 	virtual ComponentPtrBlock* GetControlBlock(const std::size_t index) = 0;
@@ -23,6 +46,34 @@ public:
 	virtual void CopyData(const std::size_t index, const void* dataSource) = 0;
 	virtual void MoveData(const std::size_t index, void* dataSource) = 0;
 	virtual ComponentPtr CloneComponent(const std::size_t index) = 0;
+	// Creates count copies of the component, writing their handles to outComponents (which must contain empty handles)
+	virtual void CloneComponents(const std::size_t index, const std::size_t count, ComponentPtr* outComponents)
+	{
+		for (std::size_t i = 0U; i < count; ++i)
+		{
+			outComponents[i] = CloneComponent(index);
+		}
+	}
+	// Called when component is attached to entity, or detached from it (entity id is invalid in that case)
+	virtual void OnComponentEntityChanged(const std::size_t, const EntityId) {}
+	// Releases storage memory, which isn't used by alive components. Component handles stay valid.
+	virtual void Compact() {}
+
+	// Returns control block of lightweight component handle, or nullptr if component has been destroyed
+	ComponentPtrBlock* ResolveHandle(const uint32_t index, const uint16_t generation) const
+	{
+		return m_handles.Resolve(index, generation);
+	}
+
+protected:
+	// Memory resource of the collection storage, used for temporary containers as well
+	std::pmr::memory_resource* GetMemoryResource() const
+	{
+		return m_handles.GetMemoryResource();
+	}
+
+	// Collections register control blocks of created components, and unregister them before destruction
+	ComponentHandleTable m_handles;
 };
 
 } // namespace ecs
@@ -0,0 +1,390 @@
+#pragma once
+#include "IComponentCollection.hpp"
+#include "ecs/storage/DenseSlotTable.hpp"
+#include "ecs/component/ComponentStorageTraits.hpp"
+#include "ecs/detail/Construct.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ecs
+{
+
+/**
+* @brief Field descriptors of component, stored in struct-of-arrays layout.
+* Specialization must contain constexpr tuple of member pointers named k_fields (see ECS_SOA_COMPONENT macro).
+*/
+template <typename ComponentType>
+struct ComponentFields;
+
+namespace detail
+{
+
+template <typename MemberPointerT>
+struct MemberPointerTraits;
+
+template <typename ClassT, typename FieldT>
+struct MemberPointerTraits<FieldT ClassT::*>
+{
+	using FieldType = FieldT;
+};
+
+} // namespace detail
+
+// Contiguous view of a single component field column
+template <typename FieldType>
+struct ColumnSpan
+{
+	FieldType* data = nullptr;
+	std::size_t size = 0U;
+
+	FieldType& operator[](const std::size_t index) const
+	{
+		return data[index];
+	}
+
+	FieldType* begin() const
+	{
+		return data;
+	}
+
+	FieldType* end() const
+	{
+		return data + size;
+	}
+};
+
+/**
+* @brief Component collection, which stores each described component field in its own contiguous column.
+*
+* Columns are dense and parallel to the slots table (sparse set layout, swap and pop removal), so field
+* updates can be done as plain loops over column spans, that compiler is able to auto-vectorize.
+* Component objects don't exist in this storage, so raw component data pointers are not available
+* (GetData returns nullptr), components are accessed using columns, or Read/Write calls.
+*/
+template <typename ComponentType>
+class SoAComponentCollection
+	: public IComponentCollection
+{
+	static_assert(std::is_trivially_copyable<ComponentType>::value, "SoA storage is supported only for trivially copyable components!");
+
+	using FieldsTuple = typename std::decay<decltype(ComponentFields<ComponentType>::k_fields)>::type;
+	static constexpr std::size_t k_fieldsCount = std::tuple_size<FieldsTuple>::value;
+	using FieldsSequence = std::make_index_sequence<k_fieldsCount>;
+
+	template <std::size_t I>
+	using FieldType = typename detail::MemberPointerTraits<typename std::tuple_element<I, FieldsTuple>::type>::FieldType;
+
+	template <typename Sequence>
+	struct ColumnsTupleBuilder;
+
+	template <std::size_t ...I>
+	struct ColumnsTupleBuilder<std::index_sequence<I...>>
+	{
+		using Type = std::tuple<std::pmr::vector<FieldType<I>>...>;
+	};
+
+	using ColumnsTuple = typename ColumnsTupleBuilder<FieldsSequence>::Type;
+
+public:
+	SoAComponentCollection(ComponentTypeId typeId, const AllocationPolicy& policy = AllocationPolicy())
+		: IComponentCollection(detail::GetMemoryResource(policy))
+		, m_columns(std::allocator_arg, std::pmr::polymorphic_allocator<std::byte>(detail::GetMemoryResource(policy)))
+		, m_slots(policy)
+		, m_typeId(typeId)
+	{}
+	~SoAComponentCollection() = default;
+
+	void Clear() final
+	{
+		m_handles.UnregisterAll();
+		ClearColumns(FieldsSequence{});
+		m_slots.Clear();
+	}
+
+	void Compact() override
+	{
+		ShrinkColumns(FieldsSequence{});
+		m_slots.Compact();
+	}
+
+	// Disable collection copy
+	SoAComponentCollection(const SoAComponentCollection&) = delete;
+	SoAComponentCollection& operator=(const SoAComponentCollection&) = delete;
+
+	ComponentPtr Create() override
+	{
+		return Emplace();
+	}
+
+	// Creates component from provided arguments and scatters its fields to columns
+	template <typename ...Args>
+	TComponentPtr<ComponentType> Emplace(Args&&... args)
+	{
+		const ComponentType component = detail::MakeObject<ComponentType>(std::forward<Args>(args)...);
+		PushFields(component, FieldsSequence{});
+
+		ComponentPtrBlock& controlBlock = m_slots.Push(m_typeId);
+		m_handles.Register(controlBlock);
+
+		return TComponentPtr<ComponentType>(&controlBlock);
+	}
+
+	void CreateComponents(const std::size_t count, ComponentPtr* outComponents) override
+	{
+		EmplaceComponents(count, outComponents);
+	}
+
+	void CreateComponents(const std::size_t count, TComponentPtr<ComponentType>* outComponents)
+	{
+		EmplaceComponents(count, outComponents);
+	}
+
+	void DestroyComponents(const std::size_t* indexes, const std::size_t count) override
+	{
+		// Removal moves the last component, so components are removed starting from the highest index to keep indexes valid
+		std::pmr::vector<std::size_t> sortedIndexes(indexes, indexes + count, GetMemoryResource());
+		std::sort(sortedIndexes.begin(), sortedIndexes.end(), std::greater<std::size_t>());
+
+		for (const std::size_t index : sortedIndexes)
+		{
+			Destroy(index);
+		}
+	}
+
+	void Destroy(const std::size_t index) override
+	{
+		assert(index < m_slots.GetSize());
+		m_handles.Unregister(m_slots.GetControlBlock(index));
+
+		RemoveSwapFields(index, FieldsSequence{});
+		m_slots.RemoveSwap(index);
+	}
+
+	void* GetData(const std::size_t) override
+	{
+		// There is no component object in columns storage
+		return nullptr;
+	}
+
+	ComponentPtrBlock* GetControlBlock(const std::size_t index) override
+	{
+		return &m_slots.GetControlBlock(index);
+	}
+
+	ComponentPtr GetItemPtr(const std::size_t index) override
+	{
+		ComponentPtrBlock* controlBlock = GetControlBlock(index);
+		if (nullptr != controlBlock && controlBlock->refCount > 0)
+		{
+			++controlBlock->refCount;
+		}
+
+		return ComponentPtr(controlBlock);
+	}
+
+	void CopyData(const std::size_t index, const void* dataSource) override
+	{
+		Write(index, *reinterpret_cast<const ComponentType*>(dataSource));
+	}
+
+	void MoveData(const std::size_t index, void* dataSource) override
+	{
+		Write(index, *reinterpret_cast<const ComponentType*>(dataSource));
+	}
+
+	ComponentPtr CloneComponent(const std::size_t index) override
+	{
+		return Emplace(Read(index));
+	}
+
+	void OnComponentEntityChanged(const std::size_t index, const EntityId entityId) override
+	{
+		m_slots.SetEntity(index, entityId);
+	}
+
+	// Gathers component fields from columns
+	ComponentType Read(const std::size_t index) const
+	{
+		ComponentType component{};
+		ReadFields(index, component, FieldsSequence{});
+
+		return component;
+	}
+
+	// Scatters component fields to columns
+	void Write(const std::size_t index, const ComponentType& component)
+	{
+		WriteFields(index, component, FieldsSequence{});
+	}
+
+	// Column access by field index (in the order of fields description)
+	template <std::size_t FieldIndex>
+	ColumnSpan<FieldType<FieldIndex>> GetColumn()
+	{
+		auto& column = std::get<FieldIndex>(m_columns);
+		return ColumnSpan<FieldType<FieldIndex>>{ column.data(), column.size() };
+	}
+
+	// Column access by described field member pointer
+	template <typename FieldT>
+	ColumnSpan<FieldT> GetColumn(FieldT ComponentType::* member)
+	{
+		ColumnSpan<FieldT> column;
+		FindColumn(member, column, FieldsSequence{});
+		assert(nullptr != column.data || m_slots.GetSize() == 0U);
+
+		return column;
+	}
+
+	// Returns dense slot of the component attached to entity, or SparseIndex::GetInvalidIndex()
+	SparseIndex::IndexType FindByEntity(const EntityId entityId) const
+	{
+		return m_slots.FindByEntity(entityId);
+	}
+
+	const EntityId* GetEntitiesData() const
+	{
+		return m_slots.GetEntitiesData();
+	}
+
+	std::size_t GetSize() const
+	{
+		return m_slots.GetSize();
+	}
+
+	// Swaps two components, keeping their handles valid (used for reordering)
+	void SwapSlots(const std::size_t leftIndex, const std::size_t rightIndex)
+	{
+		SwapFields(leftIndex, rightIndex, FieldsSequence{});
+		m_slots.Swap(leftIndex, rightIndex);
+	}
+
+	const DenseSlotTable& GetSlotTable() const
+	{
+		return m_slots;
+	}
+
+private:
+	template <typename PtrType>
+	void EmplaceComponents(const std::size_t count, PtrType* outComponents)
+	{
+		ReserveColumns(m_slots.GetSize() + count, FieldsSequence{});
+		m_slots.Reserve(count);
+
+		for (std::size_t i = 0U; i < count; ++i)
+		{
+			outComponents[i] = Emplace();
+		}
+	}
+
+	template <std::size_t ...I>
+	void ReserveColumns(const std::size_t capacity, std::index_sequence<I...>)
+	{
+		(std::get<I>(m_columns).reserve(capacity), ...);
+	}
+
+	template <std::size_t I>
+	static constexpr auto GetFieldMember()
+	{
+		return std::get<I>(ComponentFields<ComponentType>::k_fields);
+	}
+
+	template <std::size_t ...I>
+	void PushFields(const ComponentType& component, std::index_sequence<I...>)
+	{
+		(std::get<I>(m_columns).push_back(component.*GetFieldMember<I>()), ...);
+	}
+
+	template <std::size_t ...I>
+	void ReadFields(const std::size_t index, ComponentType& component, std::index_sequence<I...>) const
+	{
+		((component.*GetFieldMember<I>() = std::get<I>(m_columns)[index]), ...);
+	}
+
+	template <std::size_t ...I>
+	void WriteFields(const std::size_t index, const ComponentType& component, std::index_sequence<I...>)
+	{
+		((std::get<I>(m_columns)[index] = component.*GetFieldMember<I>()), ...);
+	}
+
+	template <std::size_t ...I>
+	void SwapFields(const std::size_t leftIndex, const std::size_t rightIndex, std::index_sequence<I...>)
+	{
+		(std::swap(std::get<I>(m_columns)[leftIndex], std::get<I>(m_columns)[rightIndex]), ...);
+	}
+
+	template <std::size_t ...I>
+	void RemoveSwapFields(const std::size_t index, std::index_sequence<I...>)
+	{
+		(RemoveSwapColumnItem(std::get<I>(m_columns), index), ...);
+	}
+
+	template <typename ColumnT>
+	static void RemoveSwapColumnItem(ColumnT& column, const std::size_t index)
+	{
+		column[index] = column.back();
+		column.pop_back();
+	}
+
+	template <std::size_t ...I>
+	void ClearColumns(std::index_sequence<I...>)
+	{
+		(std::get<I>(m_columns).clear(), ...);
+	}
+
+	template <std::size_t ...I>
+	void ShrinkColumns(std::index_sequence<I...>)
+	{
+		(std::get<I>(m_columns).shrink_to_fit(), ...);
+	}
+
+	template <typename FieldT, std::size_t ...I>
+	void FindColumn(FieldT ComponentType::* member, ColumnSpan<FieldT>& outColumn, std::index_sequence<I...>)
+	{
+		(MatchColumn<I>(member, outColumn), ...);
+	}
+
+	template <std::size_t I, typename FieldT>
+	void MatchColumn(FieldT ComponentType::* member, ColumnSpan<FieldT>& outColumn)
+	{
+		if constexpr (std::is_same<FieldType<I>, FieldT>::value)
+		{
+			if (GetFieldMember<I>() == member)
+			{
+				outColumn = GetColumn<I>();
+			}
+		}
+	}
+
+private:
+	ColumnsTuple m_columns;
+	DenseSlotTable m_slots;
+	ComponentTypeId m_typeId;
+};
+
+} // namespace ecs
+
+/**
+* Describes component fields and selects SoA storage for it, must be used in the global namespace.
+* Usage: ECS_SOA_COMPONENT(Transform, &Transform::positionX, &Transform::positionY)
+*/
+#define ECS_SOA_COMPONENT(ComponentType, ...) \
+	namespace ecs { \
+	template <> \
+	struct ComponentFields<ComponentType> \
+	{ \
+		static constexpr auto k_fields = std::make_tuple(__VA_ARGS__); \
+	}; \
+	template <> \
+	struct ComponentStorageTraits<ComponentType> \
+	{ \
+		using CollectionType = SoAComponentCollection<ComponentType>; \
+	}; \
+	}
@@ -0,0 +1,109 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace ecs
+{
+namespace detail
+{
+
+using BitWord = uint64_t;
+constexpr std::size_t k_bitWordSize = 64U;
+
+constexpr std::size_t GetBitWordsCount(const std::size_t bitsCount)
+{
+	return (bitsCount + k_bitWordSize - 1U) / k_bitWordSize;
+}
+
+// Returns index of the lowest set bit, word must be non-zero
+inline std::size_t CountTrailingZeros(const BitWord word)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return static_cast<std::size_t>(index);
+#else
+	return static_cast<std::size_t>(__builtin_ctzll(word));
+#endif
+}
+
+inline std::size_t PopCount(const BitWord word)
+{
+#ifdef _MSC_VER
+	return static_cast<std::size_t>(__popcnt64(word));
+#else
+	return static_cast<std::size_t>(__builtin_popcountll(word));
+#endif
+}
+
+// Mask with all bits at positions >= bitIndex set (bitIndex is in [0, 63])
+inline BitWord GetHighBitsMask(const std::size_t bitIndex)
+{
+	return ~BitWord(0) << bitIndex;
+}
+
+/**
+* @brief Finds first set bit with index >= startBit in words array
+* @return Index of found bit, or wordsCount * k_bitWordSize if there are no set bits left
+*/
+inline std::size_t FindNextSetBit(const BitWord* words, const std::size_t wordsCount, const std::size_t startBit)
+{
+	std::size_t wordIndex = startBit / k_bitWordSize;
+	if (wordIndex >= wordsCount)
+		return wordsCount * k_bitWordSize;
+
+	BitWord word = words[wordIndex] & GetHighBitsMask(startBit % k_bitWordSize);
+	while (word == 0U)
+	{
+		if (++wordIndex == wordsCount)
+			return wordsCount * k_bitWordSize;
+
+		word = words[wordIndex];
+	}
+
+	return wordIndex * k_bitWordSize + CountTrailingZeros(word);
+}
+
+/**
+* @brief Finds first cleared bit with index >= startBit in words array
+* @return Index of found bit, or wordsCount * k_bitWordSize if all bits are set
+*/
+inline std::size_t FindNextClearBit(const BitWord* words, const std::size_t wordsCount, const std::size_t startBit)
+{
+	std::size_t wordIndex = startBit / k_bitWordSize;
+	if (wordIndex >= wordsCount)
+		return wordsCount * k_bitWordSize;
+
+	BitWord word = ~words[wordIndex] & GetHighBitsMask(startBit % k_bitWordSize);
+	while (word == 0U)
+	{
+		if (++wordIndex == wordsCount)
+			return wordsCount * k_bitWordSize;
+
+		word = ~words[wordIndex];
+	}
+
+	return wordIndex * k_bitWordSize + CountTrailingZeros(word);
+}
+
+inline bool TestBit(const BitWord* words, const std::size_t bitIndex)
+{
+	return (words[bitIndex / k_bitWordSize] & (BitWord(1) << (bitIndex % k_bitWordSize))) != 0U;
+}
+
+inline void SetBit(BitWord* words, const std::size_t bitIndex)
+{
+	words[bitIndex / k_bitWordSize] |= BitWord(1) << (bitIndex % k_bitWordSize);
+}
+
+inline void ResetBit(BitWord* words, const std::size_t bitIndex)
+{
+	words[bitIndex / k_bitWordSize] &= ~(BitWord(1) << (bitIndex % k_bitWordSize));
+}
+
+} // namespace detail
+} // namespace ecs
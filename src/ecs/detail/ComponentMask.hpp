@@ -0,0 +1,255 @@
+#pragma once
+#include "ecs/detail/Bits.hpp"
+#include "ecs/detail/Hash.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ECS_COMPONENT_MASK_SSE2
+#endif
+
+namespace ecs
+{
+namespace detail
+{
+
+/**
+* @brief Fixed width set of component type bits, stored as an array of 64 bit words.
+*
+* Interface follows std::bitset (set, reset, test, any, none, count, bitwise operators), and adds
+* Contains, which checks that mask has all the bits of the other mask. Contains is the query matching test
+* (entity or archetype mask against query mask), and it is vectorized with AVX2 or SSE2, when available,
+* processing 256 or 128 bits per step and exiting on the first mismatching step, where std::bitset builds
+* a temporary mask and compares it. Width is rounded up to whole words.
+*/
+template <std::size_t BitsCount>
+class ComponentMask
+{
+public:
+	static constexpr std::size_t k_wordsCount = GetBitWordsCount(BitsCount);
+	static constexpr std::size_t k_bitsCount = k_wordsCount * k_bitWordSize;
+
+	static_assert(k_wordsCount > 0U, "Component mask must have at least one word");
+
+	constexpr std::size_t size() const
+	{
+		return k_bitsCount;
+	}
+
+	bool test(const std::size_t bitIndex) const
+	{
+		assert(bitIndex < k_bitsCount);
+		return TestBit(m_words, bitIndex);
+	}
+
+	ComponentMask& set(const std::size_t bitIndex)
+	{
+		assert(bitIndex < k_bitsCount);
+		SetBit(m_words, bitIndex);
+		return *this;
+	}
+
+	ComponentMask& set(const std::size_t bitIndex, const bool value)
+	{
+		return value ? set(bitIndex) : reset(bitIndex);
+	}
+
+	ComponentMask& reset(const std::size_t bitIndex)
+	{
+		assert(bitIndex < k_bitsCount);
+		ResetBit(m_words, bitIndex);
+		return *this;
+	}
+
+	ComponentMask& reset()
+	{
+		for (std::size_t i = 0U; i < k_wordsCount; ++i)
+		{
+			m_words[i] = 0U;
+		}
+
+		return *this;
+	}
+
+	bool any() const
+	{
+		BitWord result = 0U;
+		for (std::size_t i = 0U; i < k_wordsCount; ++i)
+		{
+			result |= m_words[i];
+		}
+
+		return result != 0U;
+	}
+
+	bool none() const
+	{
+		return !any();
+	}
+
+	std::size_t count() const
+	{
+		std::size_t result = 0U;
+		for (std::size_t i = 0U; i < k_wordsCount; ++i)
+		{
+			result += PopCount(m_words[i]);
+		}
+
+		return result;
+	}
+
+	// Returns count of set bits with index < bitIndex, which aren't set in excluded mask
+	std::size_t CountBelow(const std::size_t bitIndex, const ComponentMask& excluded) const
+	{
+		const std::size_t wordIndex = bitIndex / k_bitWordSize;
+		std::size_t result = 0U;
+		for (std::size_t i = 0U; i < wordIndex; ++i)
+		{
+			result += PopCount(m_words[i] & ~excluded.m_words[i]);
+		}
+
+		const std::size_t bitInWord = bitIndex % k_bitWordSize;
+		if (bitInWord != 0U)
+		{
+			result += PopCount(m_words[wordIndex] & ~excluded.m_words[wordIndex] & ~GetHighBitsMask(bitInWord));
+		}
+
+		return result;
+	}
+
+	// Returns true if every bit, set in other mask, is set in this mask
+	bool Contains(const ComponentMask& other) const
+	{
+		std::size_t i = 0U;
+#if defined(__AVX2__)
+		for (; i + 4U <= k_wordsCount; i += 4U)
+		{
+			const __m256i words = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(m_words + i));
+			const __m256i otherWords = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(other.m_words + i));
+			if (!_mm256_testc_si256(words, otherWords))
+				return false;
+		}
+#elif defined(ECS_COMPONENT_MASK_SSE2)
+		const __m128i zero = _mm_setzero_si128();
+		for (; i + 2U <= k_wordsCount; i += 2U)
+		{
+			const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_words + i));
+			const __m128i otherWords = _mm_loadu_si128(reinterpret_cast<const __m128i*>(other.m_words + i));
+			const __m128i missing = _mm_andnot_si128(words, otherWords);
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(missing, zero)) != 0xFFFF)
+				return false;
+		}
+#endif
+		for (; i < k_wordsCount; ++i)
+		{
+			if ((other.m_words[i] & ~m_words[i]) != 0U)
+				return false;
+		}
+
+		return true;
+	}
+
+	// Returns index of the first set bit with index >= startBit, or size() if there are no such bits
+	std::size_t FindNext(const std::size_t startBit) const
+	{
+		return FindNextSetBit(m_words, k_wordsCount, startBit);
+	}
+
+	// Calls func(bitIndex) for every set bit in ascending order
+	template <typename Func>
+	void ForEachSetBit(Func&& func) const
+	{
+		for (std::size_t i = 0U; i < k_wordsCount; ++i)
+		{
+			for (BitWord word = m_words[i]; word != 0U; word &= word - 1U)
+			{
+				func(i * k_bitWordSize + CountTrailingZeros(word));
+			}
+		}
+	}
+
+	ComponentMask& operator&=(const ComponentMask& other)
+	{
+		for (std::size_t i = 0U; i < k_wordsCount; ++i)
+		{
+			m_words[i] &= other.m_words[i];
+		}
+
+		return *this;
+	}
+
+	ComponentMask& operator|=(const ComponentMask& other)
+	{
+		for (std::size_t i = 0U; i < k_wordsCount; ++i)
+		{
+			m_words[i] |= other.m_words[i];
+		}
+
+		return *this;
+	}
+
+	ComponentMask operator&(const ComponentMask& other) const
+	{
+		ComponentMask result(*this);
+		return result &= other;
+	}
+
+	ComponentMask operator|(const ComponentMask& other) const
+	{
+		ComponentMask result(*this);
+		return result |= other;
+	}
+
+	bool operator==(const ComponentMask& other) const
+	{
+		for (std::size_t i = 0U; i < k_wordsCount; ++i)
+		{
+			if (m_words[i] != other.m_words[i])
+				return false;
+		}
+
+		return true;
+	}
+
+	bool operator!=(const ComponentMask& other) const
+	{
+		return !(*this == other);
+	}
+
+	std::size_t GetHash() const
+	{
+		std::size_t seed = 0U;
+		for (std::size_t i = 0U; i < k_wordsCount; ++i)
+		{
+			hash_combine(seed, std::hash<BitWord>()(m_words[i]));
+		}
+
+		return seed;
+	}
+
+private:
+	BitWord m_words[k_wordsCount] = {};
+};
+
+}
+}
+
+namespace std
+{
+
+template <std::size_t BitsCount>
+struct hash<ecs::detail::ComponentMask<BitsCount>>
+{
+	std::size_t operator()(const ecs::detail::ComponentMask<BitsCount>& mask) const
+	{
+		return mask.GetHash();
+	}
+};
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ecs
+{
+namespace detail
+{
+
+/**
+* @brief Creates object from provided arguments, using brace initialization for aggregates without suitable constructor.
+* Result is a prvalue, so it's constructed directly inside the initialized object (no temporaries are created).
+*/
+template <typename T, typename ...Args>
+T MakeObject(Args&&... args)
+{
+	if constexpr (std::is_constructible<T, Args...>::value)
+	{
+		return T(std::forward<Args>(args)...);
+	}
+	else
+	{
+		return T{ std::forward<Args>(args)... };
+	}
+}
+
+// Constructs object in the provided uninitialized memory location
+template <typename T, typename ...Args>
+T* ConstructAt(void* location, Args&&... args)
+{
+	return new (location) T(MakeObject<T>(std::forward<Args>(args)...));
+}
+
+} // namespace detail
+} // namespace ecs
@@ -0,0 +1,42 @@
+#pragma once
+#include "ecs/TypeAliases.hpp"
+
+#include <cstdint>
+
+namespace ecs
+{
+namespace detail
+{
+
+/*
+* Entity id keeps entity storage index in the low bits and generation of the storage slot in the high bits.
+* Slot generation is incremented, when entity is destroyed, so ids of destroyed entities never match the entity,
+* which reuses the slot. Slot, which reaches the last generation, is retired instead of being reused, so generations
+* never wrap around, and stale ids stay invalid however often the slot is reused. Sign bit is never set, and
+* the highest index is reserved, so valid ids never match Entity::GetInvalidId (std::numeric_limits<EntityId>::max()).
+*/
+constexpr uint32_t k_entityIndexBits = 22U;
+constexpr uint32_t k_entityGenerationBits = 32U;
+constexpr uint32_t k_entityIndexMask = (uint32_t(1) << k_entityIndexBits) - 1U;
+constexpr uint32_t k_entityGenerationMask = uint32_t((uint64_t(1) << k_entityGenerationBits) - 1U);
+constexpr uint32_t k_maxEntitiesCount = k_entityIndexMask;
+
+static_assert(k_entityIndexBits + k_entityGenerationBits < sizeof(EntityId) * 8U, "Entity id bits must leave the sign bit clear");
+
+constexpr uint32_t GetEntityIndex(const EntityId id)
+{
+	return static_cast<uint32_t>(static_cast<uint64_t>(id) & k_entityIndexMask);
+}
+
+constexpr uint32_t GetEntityGeneration(const EntityId id)
+{
+	return static_cast<uint32_t>((static_cast<uint64_t>(id) >> k_entityIndexBits) & k_entityGenerationMask);
+}
+
+constexpr EntityId MakeEntityId(const uint32_t index, const uint32_t generation)
+{
+	return static_cast<EntityId>((uint64_t(generation & k_entityGenerationMask) << k_entityIndexBits) | (index & k_entityIndexMask));
+}
+
+}
+}
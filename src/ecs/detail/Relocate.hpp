@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ecs
+{
+
+/**
+* @brief Tells storages, that object can be moved to another address by copying its bytes, leaving source memory
+* uninitialized without running its destructor. True for trivially copyable types, specialize it
+* (or use ECS_TRIVIALLY_RELOCATABLE macro) for types, which don't keep pointers into themselves.
+*/
+template <typename T>
+struct IsTriviallyRelocatable
+	: std::integral_constant<bool, std::is_trivially_copyable<T>::value>
+{};
+
+namespace detail
+{
+
+template <typename T>
+void DestroyAt(T* object)
+{
+	if constexpr (!std::is_trivially_destructible<T>::value)
+	{
+		object->~T();
+	}
+}
+
+template <typename T>
+void DestroyRange(T* first, const std::size_t count)
+{
+	if constexpr (!std::is_trivially_destructible<T>::value)
+	{
+		for (std::size_t i = 0U; i < count; ++i)
+		{
+			first[i].~T();
+		}
+	}
+}
+
+// Moves object into uninitialized destination, source is left uninitialized
+template <typename T>
+void RelocateAt(T* destination, T* source)
+{
+	if constexpr (IsTriviallyRelocatable<T>::value)
+	{
+		std::memcpy(static_cast<void*>(destination), static_cast<const void*>(source), sizeof(T));
+	}
+	else
+	{
+		new (destination) T(std::move(*source));
+		source->~T();
+	}
+}
+
+// Moves objects range into uninitialized destination, destination must precede source when ranges overlap
+template <typename T>
+void RelocateRange(T* destination, T* source, const std::size_t count)
+{
+	if constexpr (IsTriviallyRelocatable<T>::value)
+	{
+		std::memmove(static_cast<void*>(destination), static_cast<const void*>(source), count * sizeof(T));
+	}
+	else
+	{
+		for (std::size_t i = 0U; i < count; ++i)
+		{
+			RelocateAt(destination + i, source + i);
+		}
+	}
+}
+
+} // namespace detail
+} // namespace ecs
+
+// Marks type as trivially relocatable, must be used in the global namespace
+#define ECS_TRIVIALLY_RELOCATABLE(Type) \
+	namespace ecs { \
+	template <> \
+	struct IsTriviallyRelocatable<Type> \
+		: std::true_type \
+	{}; \
+	}
@@ -0,0 +1,46 @@
+#include "ecs/detail/TypeSequence.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+
+struct TypeFamilyRegistry
+{
+	std::unordered_map<std::type_index, uint32_t> indexes;
+};
+
+const std::size_t k_familiesCount = 2U;
+
+std::mutex& GetRegistryMutex()
+{
+	static std::mutex mutex;
+	return mutex;
+}
+
+TypeFamilyRegistry& GetFamilyRegistry(const ecs::detail::TypeFamily family)
+{
+	static TypeFamilyRegistry registries[k_familiesCount];
+	return registries[static_cast<std::size_t>(family)];
+}
+
+}
+
+namespace ecs
+{
+namespace detail
+{
+
+uint32_t GetTypeSequenceIndex(const TypeFamily family, const std::type_index& typeIndex)
+{
+	std::lock_guard<std::mutex> lock(GetRegistryMutex());
+
+	TypeFamilyRegistry& registry = GetFamilyRegistry(family);
+	const uint32_t nextIndex = static_cast<uint32_t>(registry.indexes.size());
+
+	return registry.indexes.emplace(typeIndex, nextIndex).first->second;
+}
+
+}
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include "raven_ecs_export.h"
+#include <cstdint>
+#include <typeindex>
+
+namespace ecs
+{
+namespace detail
+{
+
+// Families of types with independent sequence indexes
+enum class TypeFamily : uint8_t
+{
+	Component,
+	System
+};
+
+/**
+* @brief Returns sequential index of the type in the family, assigning new index on the first request for the type.
+* Registry lives in the library, so all modules get the same index for the same type. Call is thread safe.
+*/
+uint32_t ECS_API GetTypeSequenceIndex(const TypeFamily family, const std::type_index& typeIndex);
+
+// Sequence index of the type, requested from the registry once and cached per module
+template <TypeFamily Family, typename T>
+uint32_t TypeSequenceIndex()
+{
+	static const uint32_t k_index = GetTypeSequenceIndex(Family, typeid(T));
+	return k_index;
+}
+
+}
+}
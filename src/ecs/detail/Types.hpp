@@ -11,6 +11,12 @@ struct ECS_API ComponentPtrBlock
 	int32_t dataIndex;
 	EntityId entityId;
 	int32_t refCount;
+	// Cached component address, kept valid by collections, which don't move components or patch moved ones.
+	// Null means the address is resolved through the collection (e.g. SoA and archetype storages).
+	void* data;
+	// Slot of the block in collection handle table, and generation of the slot, identifying lightweight handles
+	uint32_t handleIndex;
+	uint16_t handleGeneration;
 
 	ComponentPtrBlock();
 	ComponentPtrBlock(ComponentTypeId inTypeId, int32_t inDataIndex, EntityId inEntityId, int32_t inRefCount);
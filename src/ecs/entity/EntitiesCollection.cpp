@@ -1,51 +1,86 @@
 #include "ecs/entity/EntitiesCollection.hpp"
 #include "ecs/Manager.hpp"
 
+#include <algorithm>
 #include <functional>
 
 namespace
 {
-const uint16_t k_invalidOrderInParent = uint16_t(-1);
 const ecs::EntityId k_invalidEntityId = std::numeric_limits<ecs::EntityId>::max();
+
+ecs::AllocationPolicy MakeEntitiesAllocationPolicy(std::pmr::memory_resource* resource)
+{
+	ecs::AllocationPolicy policy;
+	policy.resource = resource;
+
+	return policy;
+}
 }
 
 namespace ecs
 {
 
-EntitiesCollection::EntitiesCollection()
-	: m_entitiesData(1024U)
+EntitiesCollection::EntitiesCollection(std::pmr::memory_resource* resource)
+	: m_resource(resource)
+	, m_entitiesData(1024U, MakeEntitiesAllocationPolicy(resource))
+	, m_entitiesColdData(1024U, MakeEntitiesAllocationPolicy(resource))
+	, m_hierarchy(resource)
+	, m_childrenLocations(resource)
+	, m_freeChildrenBlocks(k_childrenCapacityClassesCount, resource)
+	, m_levels(resource)
+	, m_generations(resource)
+	, m_storageHoles(resource)
 {}
 
 void EntitiesCollection::Clear()
 {
+	// Ids of cleared entities must not resolve to entities, created in the same locations later.
+	// Cleared storage is refilled from the first location, so retired locations are reused here, wrapping their generation.
+	for (uint32_t& generation : m_generations)
+	{
+		generation = (generation + 1U) & detail::k_entityGenerationMask;
+	}
+
 	m_entitiesData.Clear();
+	m_entitiesColdData.Clear();
+	m_storageHoles.clear();
+
+	std::fill(m_hierarchy.begin(), m_hierarchy.end(), HierarchyNode());
+	m_childrenLocations.clear();
+	for (std::pmr::vector<uint32_t>& freeBlocks : m_freeChildrenBlocks)
+	{
+		freeBlocks.clear();
+	}
+	m_levels.clear();
 }
 
-Entity EntitiesCollection::GetEntityById(const EntityId id)
+std::size_t EntitiesCollection::Compact()
 {
-	auto it = m_entityIdsMap.find(id);
-	if (it != m_entityIdsMap.end())
+	// Sorted holes array is a valid min heap, so heap is restored by sorting
+	std::sort(m_storageHoles.begin(), m_storageHoles.end());
+
+	while (!m_storageHoles.empty() && m_storageHoles.back() + 1U == m_entitiesData.GetItemsCount())
 	{
-		uint32_t location = it->second;
-		EntityData* entityData = GetEntityData(id);
-		return Entity(entityData);
+		m_entitiesData.pop_back();
+		m_entitiesColdData.pop_back();
+		m_storageHoles.pop_back();
 	}
 
-	return Entity();
+	m_storageHoles.shrink_to_fit();
+
+	return m_entitiesData.ReleaseUnusedChunks() + m_entitiesColdData.ReleaseUnusedChunks();
+}
+
+Entity EntitiesCollection::GetEntityById(const EntityId id)
+{
+	EntityData* entityData = GetEntityData(id);
+	return (nullptr != entityData) ? Entity(entityData) : Entity();
 }
 
 Entity EntitiesCollection::CreateEntity()
 {
 	EntityData* entityData = AllocateEntityData();
-	const EntityId newEntityId = m_nextEntityId;
-	++m_nextEntityId;
-
-	entityData->id = newEntityId;
-	entityData->parentId = Entity::GetInvalidId();
-	entityData->orderInParent = k_invalidOrderInParent;
-
-	// Add entity to ids map
-	m_entityIdsMap.emplace(entityData->id, entityData->storageLocation);
+	InitializeEntityData(*entityData);
 
 	// Invoke global callback
 	Entity createdEntity(entityData);
@@ -54,58 +89,114 @@ Entity EntitiesCollection::CreateEntity()
 	return createdEntity;
 }
 
-void EntitiesCollection::MoveEntityData(EntityData& entityData, const uint32_t newLocation)
+void EntitiesCollection::CreateEntities(const std::size_t count, Entity* outEntities)
 {
-	EntityData* newLocationDataPtr = m_entitiesData[newLocation];
-	*newLocationDataPtr = std::move(entityData);
+	// Bookkeeping arrays grow once for the entities, which don't fit into destroyed entities locations
+	const std::size_t newLocationsCount = (count > m_storageHoles.size()) ? count - m_storageHoles.size() : 0U;
+	m_generations.reserve(m_entitiesData.GetItemsCount() + newLocationsCount);
+	m_hierarchy.reserve(m_entitiesData.GetItemsCount() + newLocationsCount);
+
+	std::size_t createdCount = 0U;
+	if (count >= m_storageHoles.size())
+	{
+		// All destroyed entities locations are reused, so they are taken in ascending order without heap pops
+		std::sort(m_storageHoles.begin(), m_storageHoles.end());
+		for (const uint32_t location : m_storageHoles)
+		{
+			EntityData* entityData = m_entitiesData[location];
+			entityData->storageLocation = location;
+			InitializeEntityData(*entityData);
+			outEntities[createdCount++] = Entity(entityData);
+		}
+
+		m_storageHoles.clear();
+	}
+
+	for (; createdCount < count; ++createdCount)
+	{
+		EntityData* entityData = AllocateEntityData();
+		InitializeEntityData(*entityData);
+		outEntities[createdCount] = Entity(entityData);
+	}
 }
 
 void EntitiesCollection::OnEntityDataDestroy(EntityId entityId)
 {
-	// Find entity data location
-	auto it = m_entityIdsMap.find(entityId);
-	assert(it != m_entityIdsMap.end());
+	EntityData* entityData = GetEntityData(entityId);
+	assert(nullptr != entityData);
 
-	uint32_t location = it->second;
-	EntityData* entityData = m_entitiesData[location];
-
-	// Remove from entity id -> storage location mapping
-	m_entityIdsMap.erase(it);
+	// Advance location generation, so the id stops resolving to the entity
+	const uint32_t location = detail::GetEntityIndex(entityId);
+	++m_generations[location];
 
 	// Detach all components from entity
 	for (const auto& componentHandle : entityData->components)
 	{
 		entityData->componentsMask.reset(componentHandle.GetTypeId());
 		componentHandle.m_block->entityId = k_invalidEntityId;
+		Manager::Get()->GetCollection(componentHandle.m_block->typeId)->OnComponentEntityChanged(componentHandle.m_block->dataIndex, k_invalidEntityId);
 
 		Manager::Get()->HandleComponentDetach(entityId, componentHandle);
 	}
 	entityData->components.clear();
 
+	// Tags have no handles, so their caches are touched by the mask
+	Manager::Get()->HandleTagsDetach(entityId, entityData->componentsMask);
+	entityData->componentsMask.reset();
+
+	// Release children and leave the parent, children become roots
+	DetachFromParent(location);
+	ClearChildren(*entityData);
+	RemoveFromLevel(location);
+
 	// Replace the entity data with newly created one
 	if (!Manager::Get()->m_isBeingDestroyed)
 	{
-		m_storageHoles.push_back(location);
-		*entityData = EntityData();
+		// Location, which reached the last generation, is retired, so its generation never wraps around
+		if (m_generations[location] != detail::k_entityGenerationMask)
+		{
+			m_storageHoles.push_back(location);
+			std::push_heap(m_storageHoles.begin(), m_storageHoles.end(), std::greater<uint32_t>());
+		}
+		*entityData = EntityData(m_resource);
+		*m_entitiesColdData[location] = EntityColdData(m_resource);
 	}
 
 	// Invoke global callback, when entity has already been destroyed
 	Manager::Get()->GetEntityDestroyDelegate().Broadcast(entityId);
 }
 
+void EntitiesCollection::InitializeEntityData(EntityData& entityData)
+{
+	const uint32_t location = entityData.storageLocation;
+	entityData.id = detail::MakeEntityId(location, m_generations[location]);
+	AddToLevel(location, Entity::GetInvalidId());
+}
+
 EntityData* EntitiesCollection::AllocateEntityData()
 {
 	if (m_storageHoles.empty())
 	{
-		auto entityCreationResult = m_entitiesData.CreateItem();
+		assert(m_entitiesData.GetItemsCount() < detail::k_maxEntitiesCount && "Entity id index bits are exhausted");
+
+		auto entityCreationResult = m_entitiesData.CreateItem(m_resource);
 		entityCreationResult.second->storageLocation = static_cast<EntityHandleIndex>(entityCreationResult.first);
+		m_entitiesColdData.CreateItem(m_resource);
+
+		// Generations of trimmed locations are kept, so reused locations continue their generation sequence
+		if (entityCreationResult.first >= m_generations.size())
+		{
+			m_generations.push_back(0U);
+			m_hierarchy.emplace_back();
+		}
 
 		return entityCreationResult.second;
 	}
 	else
 	{
-		uint32_t location = m_storageHoles.front();
-		m_storageHoles.pop_front();
+		std::pop_heap(m_storageHoles.begin(), m_storageHoles.end(), std::greater<uint32_t>());
+		uint32_t location = m_storageHoles.back();
+		m_storageHoles.pop_back();
 
 		EntityData* data = m_entitiesData[location];
 		data->storageLocation = location;
@@ -114,15 +205,237 @@ EntityData* EntitiesCollection::AllocateEntityData()
 	}
 }
 
-EntityData* EntitiesCollection::GetEntityData(const EntityId id)
+void EntitiesCollection::AddChild(EntityData& parent, EntityData& child)
 {
-	auto it = m_entityIdsMap.find(id);
-	if (it != m_entityIdsMap.end())
+	const uint32_t parentLocation = parent.storageLocation;
+	const uint32_t childLocation = child.storageLocation;
+
+	// Entity can't become a child of its own descendant
+	for (uint32_t location = parentLocation; location != k_invalidLocation; location = m_hierarchy[location].parent)
+	{
+		if (location == childLocation)
+		{
+			assert(false && "Entity can't be attached to its descendant");
+			return;
+		}
+	}
+
+	// Attached child is moved, parent reference is kept
+	const bool isReattached = (k_invalidLocation != m_hierarchy[childLocation].parent);
+	DetachFromParent(childLocation);
+
+	// Children count never reaches the invalid order, as blocks of the largest capacity class fit all entities
+	HierarchyNode& parentNode = m_hierarchy[parentLocation];
+
+	const uint32_t capacity = (k_noChildrenBlock != parentNode.childrenCapacityClass) ? (uint32_t(1) << parentNode.childrenCapacityClass) : 0U;
+	if (parentNode.childrenCount == capacity)
 	{
-		return m_entitiesData[it->second];
+		const uint8_t capacityClass = (0U == capacity) ? k_minChildrenCapacityClass : static_cast<uint8_t>(parentNode.childrenCapacityClass + 1U);
+		const uint32_t offset = AllocateChildrenBlock(capacityClass);
+
+		// Node reference may be invalidated by children locations growth, but hierarchy array doesn't grow here
+		std::copy_n(m_childrenLocations.begin() + parentNode.childrenOffset, parentNode.childrenCount, m_childrenLocations.begin() + offset);
+		FreeChildrenBlock(parentNode);
+		parentNode.childrenOffset = offset;
+		parentNode.childrenCapacityClass = capacityClass;
+	}
+
+	m_childrenLocations[parentNode.childrenOffset + parentNode.childrenCount] = childLocation;
+
+	HierarchyNode& childNode = m_hierarchy[childLocation];
+	childNode.parent = parentLocation;
+	childNode.orderInParent = parentNode.childrenCount;
+	++parentNode.childrenCount;
+
+	SetSubtreeDepth(childLocation, static_cast<uint16_t>(parentNode.depth + 1U));
+	SetLevelParent(childLocation, parent.id);
+
+	if (!isReattached)
+	{
+		++child.refCount;
+	}
+}
+
+bool EntitiesCollection::RemoveChild(EntityData& parent, EntityData& child)
+{
+	if (m_hierarchy[child.storageLocation].parent != parent.storageLocation)
+		return false;
+
+	DetachFromParent(child.storageLocation);
+	return true;
+}
+
+void EntitiesCollection::ClearChildren(EntityData& parent)
+{
+	const uint32_t parentLocation = parent.storageLocation;
+
+	// Children are detached from the last one, so no locations are shifted, references are released after detaching,
+	// because released child can be destroyed, changing the hierarchy
+	while (m_hierarchy[parentLocation].childrenCount > 0U)
+	{
+		const HierarchyNode& parentNode = m_hierarchy[parentLocation];
+		const uint32_t childLocation = m_childrenLocations[parentNode.childrenOffset + parentNode.childrenCount - 1U];
+
+		DetachFromParent(childLocation);
+		ReleaseChildReference(m_entitiesData[childLocation]);
+	}
+
+	FreeChildrenBlock(m_hierarchy[parentLocation]);
+}
+
+EntityData* EntitiesCollection::GetChildData(const EntityData& parent, const std::size_t index)
+{
+	const HierarchyNode& parentNode = m_hierarchy[parent.storageLocation];
+	if (index < parentNode.childrenCount)
+	{
+		return m_entitiesData[m_childrenLocations[parentNode.childrenOffset + index]];
 	}
 
 	return nullptr;
 }
 
+EntityData* EntitiesCollection::GetParentData(const EntityData& child)
+{
+	const uint32_t parentLocation = m_hierarchy[child.storageLocation].parent;
+	return (k_invalidLocation != parentLocation) ? m_entitiesData[parentLocation] : nullptr;
+}
+
+void EntitiesCollection::DetachFromParent(const uint32_t location)
+{
+	HierarchyNode& node = m_hierarchy[location];
+	if (k_invalidLocation == node.parent)
+		return;
+
+	// Following siblings are shifted to keep children order
+	HierarchyNode& parentNode = m_hierarchy[node.parent];
+	const uint32_t blockStart = parentNode.childrenOffset;
+	for (uint32_t i = node.orderInParent + 1U; i < parentNode.childrenCount; ++i)
+	{
+		const uint32_t siblingLocation = m_childrenLocations[blockStart + i];
+		m_childrenLocations[blockStart + i - 1U] = siblingLocation;
+		m_hierarchy[siblingLocation].orderInParent = i - 1U;
+	}
+	--parentNode.childrenCount;
+
+	node.parent = k_invalidLocation;
+	node.orderInParent = k_invalidOrderInParent;
+	SetSubtreeDepth(location, 0U);
+	SetLevelParent(location, Entity::GetInvalidId());
+}
+
+void EntitiesCollection::SetSubtreeDepth(const uint32_t location, const uint16_t depth)
+{
+	if (m_hierarchy[location].depth == depth)
+		return;
+
+	// Parents are visited before their children, so every descendant takes the depth next to its moved parent
+	MoveToLevel(location, depth);
+	for (uint32_t current = GetNextInSubtree(location, location); current != k_invalidLocation; current = GetNextInSubtree(current, location))
+	{
+		MoveToLevel(current, static_cast<uint16_t>(m_hierarchy[m_hierarchy[current].parent].depth + 1U));
+	}
+}
+
+uint32_t EntitiesCollection::GetNextInSubtree(const uint32_t location, const uint32_t root) const
+{
+	// Depth first walk uses children blocks and parent links, so it doesn't need a stack
+	const HierarchyNode& node = m_hierarchy[location];
+	if (node.childrenCount > 0U)
+	{
+		return m_childrenLocations[node.childrenOffset];
+	}
+
+	// Climb to the closest ancestor inside the subtree, which has the next sibling
+	for (uint32_t current = location; current != root; current = m_hierarchy[current].parent)
+	{
+		const HierarchyNode& currentNode = m_hierarchy[current];
+		const HierarchyNode& parentNode = m_hierarchy[currentNode.parent];
+		if (currentNode.orderInParent + 1U < parentNode.childrenCount)
+		{
+			return m_childrenLocations[parentNode.childrenOffset + currentNode.orderInParent + 1U];
+		}
+	}
+
+	return k_invalidLocation;
+}
+
+void EntitiesCollection::ReleaseChildReference(EntityData* child)
+{
+	// Temporary entity holds the child, while parent reference is dropped, and destroys it on scope exit, if it was the last one
+	Entity childEntity(child);
+	--child->refCount;
+}
+
+void EntitiesCollection::AddToLevel(const uint32_t location, const EntityId parentId)
+{
+	HierarchyNode& node = m_hierarchy[location];
+	while (m_levels.size() <= node.depth)
+	{
+		m_levels.emplace_back(m_resource);
+	}
+
+	HierarchyLevel& level = m_levels[node.depth];
+	node.levelSlot = static_cast<uint32_t>(level.entities.size());
+	level.entities.push_back(m_entitiesData[location]->id);
+	level.parents.push_back(parentId);
+}
+
+void EntitiesCollection::RemoveFromLevel(const uint32_t location)
+{
+	const HierarchyNode& node = m_hierarchy[location];
+	HierarchyLevel& level = m_levels[node.depth];
+
+	// Last entity of the level takes the slot, its location is encoded in its id
+	const EntityId lastEntityId = level.entities.back();
+	level.entities[node.levelSlot] = lastEntityId;
+	level.parents[node.levelSlot] = level.parents.back();
+	m_hierarchy[detail::GetEntityIndex(lastEntityId)].levelSlot = node.levelSlot;
+
+	level.entities.pop_back();
+	level.parents.pop_back();
+}
+
+void EntitiesCollection::MoveToLevel(const uint32_t location, const uint16_t depth)
+{
+	HierarchyNode& node = m_hierarchy[location];
+	const EntityId parentId = m_levels[node.depth].parents[node.levelSlot];
+
+	RemoveFromLevel(location);
+	node.depth = depth;
+	AddToLevel(location, parentId);
+}
+
+void EntitiesCollection::SetLevelParent(const uint32_t location, const EntityId parentId)
+{
+	const HierarchyNode& node = m_hierarchy[location];
+	m_levels[node.depth].parents[node.levelSlot] = parentId;
+}
+
+uint32_t EntitiesCollection::AllocateChildrenBlock(const uint8_t capacityClass)
+{
+	std::pmr::vector<uint32_t>& freeBlocks = m_freeChildrenBlocks[capacityClass];
+	if (!freeBlocks.empty())
+	{
+		const uint32_t offset = freeBlocks.back();
+		freeBlocks.pop_back();
+
+		return offset;
+	}
+
+	const uint32_t offset = static_cast<uint32_t>(m_childrenLocations.size());
+	m_childrenLocations.resize(m_childrenLocations.size() + (std::size_t(1) << capacityClass), k_invalidLocation);
+
+	return offset;
+}
+
+void EntitiesCollection::FreeChildrenBlock(HierarchyNode& node)
+{
+	if (k_noChildrenBlock != node.childrenCapacityClass)
+	{
+		m_freeChildrenBlocks[node.childrenCapacityClass].push_back(node.childrenOffset);
+		node.childrenCapacityClass = k_noChildrenBlock;
+		node.childrenOffset = 0U;
+	}
+}
+
 } // namespace ecs
@@ -2,22 +2,49 @@
 #include "ecs/entity/EntityData.hpp"
 #include "ecs/entity/Entity.hpp"
 #include "ecs/storage/MemoryPool.hpp"
+#include "ecs/detail/EntityIdBits.hpp"
 
-#include <unordered_map>
-#include <deque>
+#include <vector>
+#include <memory_resource>
 
 namespace ecs
 {
 
+/**
+* @brief Storage of entities data. Entity data, cold data and hierarchy nodes are stored at the same storage location.
+*
+* Hierarchy is kept in flat arrays: a node per location (parent location, depth, order in parent and children range),
+* and children locations of every parent stored contiguously in a shared array, so child access by index is O(1)
+* and hierarchy walks read arrays instead of chasing list nodes. Children arrays grow by power of two blocks,
+* freed blocks are reused by entities with the same capacity, so adding and removing children doesn't allocate
+* in steady state. Parent keeps a reference to each child, so children live at least as long as they are attached.
+* Every entity is also listed in the level of its depth (ids of the entity and its parent), levels are updated,
+* when subtrees move, so parent before child passes iterate levels without walking the tree.
+*/
 class EntitiesCollection
 {
 	friend struct Entity;
 	friend class ComponentsTupleCache;
-
-	using EntityIdsMap = std::unordered_map<EntityId, uint32_t>; // Mapping of entity id to entity storage location
+	friend struct ComponentHandle;
 
 public:
-	EntitiesCollection();
+	static constexpr uint32_t k_invalidLocation = uint32_t(-1);
+	static constexpr uint32_t k_invalidOrderInParent = uint32_t(-1);
+
+	// Position of the entity in hierarchy, stored per entity storage location
+	struct HierarchyNode
+	{
+		uint32_t parent = k_invalidLocation;
+		uint32_t childrenOffset = 0U; // Start of children block in children locations array
+		uint32_t childrenCount = 0U;
+		uint32_t orderInParent = k_invalidOrderInParent;
+		uint16_t depth = 0U; // Root entities have zero depth
+		uint8_t childrenCapacityClass = k_noChildrenBlock; // Children block holds 1 << class locations
+		uint32_t levelSlot = 0U; // Index of the entity in its depth level
+	};
+
+	// Entities data and bookkeeping containers are allocated from the manager memory resource
+	explicit EntitiesCollection(std::pmr::memory_resource* resource);
 
 	// Disable collection copy
 	EntitiesCollection(const EntitiesCollection&) = delete;
@@ -26,22 +53,136 @@ public:
 	Entity GetEntityById(const EntityId id);
 	Entity CreateEntity();
 
+	/**
+	* @brief Creates count entities at once, without per entity create events (used by batch instantiation)
+	* @param outEntities - array of count empty entities, which receives created entities
+	*/
+	void CreateEntities(const std::size_t count, Entity* outEntities);
+
 	void Clear();
 
+	/**
+	* @brief Trims destroyed entities from the end of entities storages, and releases unused storage chunks.
+	* Entities are referenced by data address, so alive entities never move, destroyed entities locations
+	* are reused starting from the lowest one to keep entities packed at the beginning of the storage.
+	* @return Count of released chunks
+	*/
+	std::size_t Compact();
+
+	// Entity id is the storage location and its generation (see detail::MakeEntityId), so lookup is an array access
+	EntityData* GetEntityData(const EntityId id)
+	{
+		const uint32_t location = detail::GetEntityIndex(id);
+		if (id >= 0 && location < m_entitiesData.GetItemsCount() && m_generations[location] == detail::GetEntityGeneration(id))
+		{
+			return m_entitiesData[location];
+		}
+
+		return nullptr;
+	}
+
+	// Name of the entity, located by entity data storage location
+	EntityColdData& GetColdData(const EntityHandleIndex storageLocation)
+	{
+		return *m_entitiesColdData[storageLocation];
+	}
+
+	const HierarchyNode& GetHierarchyNode(const EntityHandleIndex storageLocation) const
+	{
+		return m_hierarchy[storageLocation];
+	}
+
+	/**
+	* @brief Calls func(Entity&) for the root entity and all its descendants in depth first order (parent before
+	* its children, children in their order). Hierarchy must not be changed by func.
+	*/
+	template <typename Func>
+	void ForEachInHierarchy(const Entity& root, Func&& func)
+	{
+		if (!root.IsValid())
+			return;
+
+		// Subtree is walked by parent links, so iteration doesn't allocate
+		const uint32_t rootLocation = root.GetData()->storageLocation;
+		for (uint32_t location = rootLocation; location != k_invalidLocation; location = GetNextInSubtree(location, rootLocation))
+		{
+			Entity entity(m_entitiesData[location]);
+			func(entity);
+		}
+	}
+
+	/**
+	* @brief Iterates entities grouped by hierarchy depth, from roots to the deepest level. Invokes
+	* func(uint16_t depth, std::size_t count, const EntityId* entities, const EntityId* parents) for every level,
+	* parents of level entities are in the previous level (invalid id for roots). Entities of a level don't depend
+	* on each other, so func can split the level between worker threads, waiting for them before returning.
+	* Order of entities inside a level is not specified. Hierarchy must not be changed during iteration.
+	*/
+	template <typename Func>
+	void ForEachHierarchyLevel(Func&& func) const
+	{
+		for (std::size_t depth = 0U; depth < m_levels.size() && !m_levels[depth].entities.empty(); ++depth)
+		{
+			const HierarchyLevel& level = m_levels[depth];
+			func(static_cast<uint16_t>(depth), level.entities.size(), level.entities.data(), level.parents.data());
+		}
+	}
+
 private:
+	// Ids of the entities with the same depth and ids of their parents
+	struct HierarchyLevel
+	{
+		explicit HierarchyLevel(std::pmr::memory_resource* resource)
+			: entities(resource)
+			, parents(resource)
+		{}
+
+		std::pmr::vector<EntityId> entities;
+		std::pmr::vector<EntityId> parents;
+	};
+
+	static constexpr uint8_t k_noChildrenBlock = uint8_t(-1);
+	static constexpr uint8_t k_minChildrenCapacityClass = 2U;
+	static constexpr uint8_t k_childrenCapacityClassesCount = detail::k_entityIndexBits + 1U; // Block of the largest class fits all entities
+
+
 	using EntitiesStorageType = detail::MemoryPool<EntityData>;
+	using EntitiesColdStorageType = detail::MemoryPool<EntityColdData>;
 
-	void MoveEntityData(EntityData& entityData, const uint32_t newLocation);
 	void OnEntityDataDestroy(EntityId entityId);
 
 	EntityData* AllocateEntityData();
-	EntityData* GetEntityData(const EntityId id);
+	// Assigns id of the allocated entity data, and adds the entity to the roots level
+	void InitializeEntityData(EntityData& entityData);
+
+	// Hierarchy operations, used by Entity. Parent reference to the child is acquired by AddChild and released by the caller of RemoveChild.
+	void AddChild(EntityData& parent, EntityData& child);
+	bool RemoveChild(EntityData& parent, EntityData& child);
+	void ClearChildren(EntityData& parent);
+	EntityData* GetChildData(const EntityData& parent, const std::size_t index);
+	EntityData* GetParentData(const EntityData& child);
+
+	void DetachFromParent(const uint32_t location);
+	void SetSubtreeDepth(const uint32_t location, const uint16_t depth);
+	uint32_t GetNextInSubtree(const uint32_t location, const uint32_t root) const;
+	void ReleaseChildReference(EntityData* child);
+	void AddToLevel(const uint32_t location, const EntityId parentId);
+	void RemoveFromLevel(const uint32_t location);
+	void MoveToLevel(const uint32_t location, const uint16_t depth);
+	void SetLevelParent(const uint32_t location, const EntityId parentId);
+	uint32_t AllocateChildrenBlock(const uint8_t capacityClass);
+	void FreeChildrenBlock(HierarchyNode& node);
 
 private:
-	EntitiesStorageType m_entitiesData;
-	EntityIdsMap m_entityIdsMap;
-	EntityId m_nextEntityId = 0U;
-	std::deque<uint32_t> m_storageHoles;
+	std::pmr::memory_resource* m_resource;
+	EntitiesStorageType m_entitiesData; // Entities state, used by queries and handles
+	EntitiesColdStorageType m_entitiesColdData; // Entities names at the same locations
+	std::pmr::vector<HierarchyNode> m_hierarchy; // Hierarchy node per location
+	std::pmr::vector<uint32_t> m_childrenLocations; // Children blocks of all parents
+	std::pmr::vector<std::pmr::vector<uint32_t>> m_freeChildrenBlocks; // Offsets of freed children blocks per capacity class
+	std::pmr::vector<HierarchyLevel> m_levels; // Entities per depth
+	std::pmr::vector<uint32_t> m_generations; // Generation of each storage location, entity id is the location and its generation
+	std::pmr::vector<uint32_t> m_storageHoles; // Min heap of destroyed entities locations
 };
 
 } // namespace ecs
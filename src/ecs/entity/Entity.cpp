@@ -8,23 +8,13 @@
 namespace
 {
 const uint32_t k_invalidStorageLocation = uint32_t(-1);
-const uint16_t k_invalidOrderInParent = uint16_t(-1);
 const ecs::EntityId k_invalidEntityId = std::numeric_limits<ecs::EntityId>::max();
-const std::string k_emptyName;
 
-struct FindComponentByTypePredicate
+// Type ids outside of components mask (including invalid type id) never match entity components
+bool IsMaskTypeId(const ecs::ComponentTypeId typeId)
 {
-	ecs::ComponentTypeId typeId;
-
-	FindComponentByTypePredicate(ecs::ComponentTypeId inTypeId)
-		: typeId(inTypeId)
-	{}
-
-	bool operator()(const ecs::ComponentPtr& component)
-	{
-		return component.GetTypeId() == typeId;
-	}
-};
+	return typeId >= 0 && static_cast<std::size_t>(typeId) < ecs::ComponentMaskType::k_bitsCount;
+}
 }
 
 namespace ecs
@@ -115,12 +105,22 @@ void Entity::AddComponent(const ComponentPtr& handle)
 
 	assert(handle.m_block->entityId == k_invalidEntityId);
 
-	// Register component inside entity data
-	m_data->components.push_back(handle);
-	m_data->componentsMask.set(handle.GetTypeId());
+	const ComponentTypeId typeId = handle.m_block->typeId;
+	if (m_data->componentsMask.test(typeId))
+	{
+		// Entity owns a single component of each type
+		assert(false && "Entity already has component of this type");
+		return;
+	}
+
+	// Register component inside entity data, keeping components ordered by type id
+	const std::size_t slot = m_data->GetComponentSlot(typeId, Manager::Get()->GetTagTypesMask());
+	m_data->components.insert(m_data->components.begin() + slot, handle);
+	m_data->componentsMask.set(typeId);
 
 	// Register entity id inside component handle
 	handle.m_block->entityId = m_data->id;
+	Manager::Get()->GetCollection(handle.m_block->typeId)->OnComponentEntityChanged(handle.m_block->dataIndex, m_data->id);
 	
 	// Invoke global callback
 	Manager::Get()->GetComponentAttachedDelegate().Broadcast(*this, handle);
@@ -138,21 +138,44 @@ void Entity::RemoveComponent(const ComponentPtr& handle)
 		return;
 	}
 
-	auto it = std::find(m_data->components.begin(), m_data->components.end(), handle);
-	if (it != m_data->components.end())
+	const ComponentPtr* component = m_data->FindComponent(handle.m_block->typeId, Manager::Get()->GetTagTypesMask());
+	if (nullptr != component && *component == handle)
 	{
-		m_data->components.erase(it);
-		m_data->componentsMask.reset(handle.GetTypeId());
+		m_data->components.erase(m_data->components.begin() + (component - m_data->components.data()));
+		m_data->componentsMask.reset(handle.m_block->typeId);
 		handle.m_block->entityId = k_invalidEntityId;
+		Manager::Get()->GetCollection(handle.m_block->typeId)->OnComponentEntityChanged(handle.m_block->dataIndex, k_invalidEntityId);
 
 		// Invoke component detach delegate
-		Manager::Get()->HandleComponentDetach(handle.m_block->entityId, handle);
+		Manager::Get()->HandleComponentDetach(m_data->id, handle);
+	}
+}
+
+void Entity::AddTag(const ComponentTypeId tagType)
+{
+	assert(Manager::Get()->IsTagType(tagType));
+
+	if (!m_data->componentsMask.test(tagType))
+	{
+		m_data->componentsMask.set(tagType);
+		Manager::Get()->TouchTypeCaches(m_data->id, tagType);
+	}
+}
+
+void Entity::RemoveTag(const ComponentTypeId tagType)
+{
+	assert(Manager::Get()->IsTagType(tagType));
+
+	if (m_data->componentsMask.test(tagType))
+	{
+		m_data->componentsMask.reset(tagType);
+		Manager::Get()->TouchTypeCaches(m_data->id, tagType);
 	}
 }
 
 bool Entity::HasComponent(const ComponentTypeId componentType) const
 {
-	if (componentType == Manager::GetInvalidComponentTypeId())
+	if (!IsMaskTypeId(componentType))
 		return false;
 
 	return m_data->componentsMask.test(componentType);
@@ -162,7 +185,7 @@ bool Entity::HasComponents(ComponentTypeId* componentTypes, const std::size_t co
 {
 	for (std::size_t i = 0U; i < count; ++i)
 	{
-		if (!m_data->componentsMask.test(componentTypes[i]))
+		if (!IsMaskTypeId(componentTypes[i]) || !m_data->componentsMask.test(componentTypes[i]))
 		{
 			return false;
 		}
@@ -173,18 +196,8 @@ bool Entity::HasComponents(ComponentTypeId* componentTypes, const std::size_t co
 
 ComponentPtr Entity::GetComponent(const ComponentTypeId componentType) const
 {
-	if (HasComponent(componentType))
-	{
-		for (const ComponentPtr& component : m_data->components)
-		{
-			if (component.GetTypeId() == componentType)
-			{
-				return component;
-			}
-		}
-	}
-
-	return ComponentPtr();
+	const ComponentPtr* component = m_data->FindComponent(componentType, Manager::Get()->GetTagTypesMask());
+	return (nullptr != component) ? *component : ComponentPtr();
 }
 
 EntityId Entity::GetId() const
@@ -199,22 +212,23 @@ EntityId Entity::GetId() const
 
 std::size_t Entity::GetChildrenCount() const
 {
-	return m_data->children.size();
+	return Manager::Get()->GetEntitiesCollection().GetHierarchyNode(m_data->storageLocation).childrenCount;
 }
 
 Entity Entity::GetParent() const
 {
-	if (Entity::GetInvalidId() != m_data->parentId)
-	{
-		return Manager::Get()->GetEntitiesCollection().GetEntityById(m_data->parentId);
-	}
+	EntityData* parentData = Manager::Get()->GetEntitiesCollection().GetParentData(*m_data);
+	return (nullptr != parentData) ? Entity(parentData) : Entity();
+}
 
-	return Entity();
+uint32_t Entity::GetOrderInParent() const
+{
+	return Manager::Get()->GetEntitiesCollection().GetHierarchyNode(m_data->storageLocation).orderInParent;
 }
 
-uint16_t Entity::GetOrderInParent() const
+uint16_t Entity::GetDepth() const
 {
-	return m_data->orderInParent;
+	return Manager::Get()->GetEntitiesCollection().GetHierarchyNode(m_data->storageLocation).depth;
 }
 
 Entity Entity::Clone() const
@@ -233,10 +247,16 @@ Entity Entity::Clone() const
 			clone.AddComponent(componentClone);
 		}
 
+		// Clone tags
+		const ComponentMaskType tagsMask = m_data->componentsMask & Manager::Get()->m_tagTypesMask;
+		tagsMask.ForEachSetBit([&clone](const std::size_t typeId) {
+			clone.AddTag(static_cast<ComponentTypeId>(typeId));
+		});
+
 		// Clone children
-		for (ecs::Entity& child : GetChildren())
+		for (std::size_t i = 0U; i < GetChildrenCount(); ++i)
 		{
-			ecs::Entity childClone = child.Clone();
+			ecs::Entity childClone = GetChildByIdx(i).Clone();
 			clone.AddChild(childClone);
 		}
 
@@ -253,33 +273,21 @@ const EntityComponentsContainer& Entity::GetComponents() const
 
 void Entity::GetComponentsOfTypes(ComponentPtr* outComponents, ComponentTypeId* componentTypes, const std::size_t count) const
 {
+	const ComponentMaskType& tagTypesMask = Manager::Get()->GetTagTypesMask();
 	for (std::size_t i = 0; i < count; ++i)
 	{
-		if (HasComponent(componentTypes[i]))
-		{
-			FindComponentByTypePredicate predicate(componentTypes[i]);
-
-			auto it = std::find_if(m_data->components.begin(), m_data->components.end(), predicate);
-			if (it != m_data->components.end())
-			{
-				// Set component ptr value and go to next
-				outComponents[i] = *it;
-				continue;
-			}
-		}
-
-		// Set empty component ptr
-		outComponents[i] = ComponentPtr();
+		// Missing components and tags get empty component ptr
+		const ComponentPtr* component = m_data->FindComponent(componentTypes[i], tagTypesMask);
+		outComponents[i] = (nullptr != component) ? *component : ComponentPtr();
 	}
 }
 
 void Entity::AddChild(Entity& child)
 {
-	EntityData* childData = child.GetData();
-	childData->parentId = m_data->id;
-	childData->orderInParent = static_cast<uint16_t>(m_data->children.size());
+	if (!child.IsValid())
+		return;
 
-	m_data->children.push_back(child);
+	Manager::Get()->GetEntitiesCollection().AddChild(*m_data, *child.m_data);
 
 	// Invoke global callback
 	//if (nullptr != Manager::Get()->m_globalEntityChildAddedCallback)
@@ -290,12 +298,13 @@ void Entity::AddChild(Entity& child)
 
 void Entity::RemoveChild(Entity& child)
 {
-	auto it = std::find(m_data->children.begin(), m_data->children.end(), child);
-	if (it != m_data->children.end())
+	if (!child.IsValid())
+		return;
+
+	if (Manager::Get()->GetEntitiesCollection().RemoveChild(*m_data, *child.m_data))
 	{
-		EntityData* childData = child.GetData();
-		childData->parentId = Entity::GetInvalidId();
-		childData->orderInParent = k_invalidOrderInParent;
+		// Release parent reference, child is still referenced by the argument
+		child.RemoveRef();
 
 		// Invoke global callback
 		//if (nullptr != Manager::Get()->m_globalEntityChildRemovedCallback)
@@ -307,42 +316,18 @@ void Entity::RemoveChild(Entity& child)
 
 void Entity::ClearChildren()
 {
-	for (auto it = m_data->children.begin(); it != m_data->children.end();)
-	{
-		ecs::Entity child = *it;
-
-		EntityData* childData = child.GetData();
-		childData->parentId = Entity::GetInvalidId();
-		childData->orderInParent = k_invalidOrderInParent;
-
-		it = m_data->children.erase(it);
-
-		// Invoke global callback
-		//if (nullptr != Manager::Get()->m_globalEntityChildRemovedCallback)
-		//{
-		//	std::invoke(Manager::Get()->m_globalEntityChildRemovedCallback, *this, child.GetId());
-		//}
-	}
+	Manager::Get()->GetEntitiesCollection().ClearChildren(*m_data);
 }
 
-Entity& Entity::GetChildByIdx(const std::size_t idx) const
+Entity Entity::GetChildByIdx(const std::size_t idx) const
 {
-	std::size_t i = 0;
-	for (Entity& entity : m_data->children)
-	{
-		if (i == idx)
-			return entity;
-
-		++i;
-	}
-
-	static Entity k_empty;
-	return k_empty;
+	EntityData* childData = Manager::Get()->GetEntitiesCollection().GetChildData(*m_data, idx);
+	return (nullptr != childData) ? Entity(childData) : Entity();
 }
 
-EntityChildrenContainer& Entity::GetChildren() const
+EntityChildren Entity::GetChildren() const
 {
-	return m_data->children;
+	return EntityChildren(*this);
 }
 
 bool Entity::operator==(const Entity& other) const
@@ -384,45 +369,30 @@ EntityData* Entity::GetData() const
 	return m_data;
 }
 
+EntityColdData& Entity::GetColdData() const
+{
+	return Manager::Get()->GetEntitiesCollection().GetColdData(m_data->storageLocation);
+}
+
 ComponentTypeId Entity::GetComponentTypeIdByIndex(const std::type_index& index) const
 {
 	return Manager::Get()->GetComponentTypeIdByIndex(index);
 }
 
-void Entity::SetName(const std::string& name)
+ComponentTypeId Entity::GetComponentTypeIdBySequence(const uint32_t sequenceIndex) const
 {
-	if (name.empty())
-	{
-		m_data->name.reset();
-	}
-	else
-	{
-		m_data->name = std::make_unique<std::string>(name);
-	}
+	return Manager::Get()->GetComponentTypeIdBySequence(sequenceIndex);
 }
 
-void Entity::SetName(std::string&& name)
+void Entity::SetName(std::string_view name)
 {
-	if (name.empty())
-	{
-		m_data->name.reset();
-	}
-	else
-	{
-		m_data->name = std::make_unique<std::string>(std::move(name));
-	}
+	// Name string keeps the memory resource of the entity storage
+	GetColdData().name.assign(name.data(), name.size());
 }
 
-const std::string& Entity::GetName() const
+std::string_view Entity::GetName() const
 {
-	if (m_data->name)
-	{
-		return *m_data->name;
-	}
-	else
-	{
-		return k_emptyName;
-	}
+	return GetColdData().name;
 }
 
 } // namespace ecs
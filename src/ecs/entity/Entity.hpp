@@ -1,7 +1,10 @@
 #pragma once
 #include "ecs/entity/EntityData.hpp"
 #include "ecs/detail/Types.hpp"
+#include "ecs/detail/TypeSequence.hpp"
 
+#include <iterator>
+#include <string_view>
 #include <typeindex>
 
 namespace ecs
@@ -9,6 +12,7 @@ namespace ecs
 
 class EntitiesCollection;
 class Manager;
+class EntityChildren;
 
 typedef void(*EntityChildAddedCallback)(Entity&, EntityId);
 typedef void(*EntityChildRemovedCallback)(Entity&, EntityId);
@@ -41,37 +45,56 @@ struct ECS_API Entity
 	void AddComponent(const ComponentPtr& handle);
 	void RemoveComponent(const ComponentPtr& handle);
 	bool HasComponent(const ComponentTypeId componentType) const;
+	// Tags (empty types) are only bits of the components mask, adding or removing them flips the bit and updates
+	// tuple caches without allocating (see Manager::RegisterTagType)
+	void AddTag(const ComponentTypeId tagType);
+	void RemoveTag(const ComponentTypeId tagType);
 	bool HasComponents(ComponentTypeId* componentTypes, const std::size_t count) const;
 	ComponentPtr GetComponent(const ComponentTypeId componentType) const;
 	const EntityComponentsContainer& GetComponents() const;
 	void GetComponentsOfTypes(ComponentPtr* outComponents, ComponentTypeId* componentTypes, const std::size_t count) const;
 
+	// Parent keeps a reference to its children, attached child is moved from its previous parent
 	void AddChild(Entity& child);
 	void RemoveChild(Entity& child);
 	void ClearChildren();
-	Entity& GetChildByIdx(const std::size_t idx) const;
-	EntityChildrenContainer& GetChildren() const;
+	Entity GetChildByIdx(const std::size_t idx) const;
+	EntityChildren GetChildren() const;
 	std::size_t GetChildrenCount() const;
 	Entity GetParent() const;
-	uint16_t GetOrderInParent() const;
+	uint32_t GetOrderInParent() const;
+	// Count of ancestors, root entities have zero depth
+	uint16_t GetDepth() const;
 
 	EntityId GetId() const;
 
-	void SetName(const std::string& name);
-	void SetName(std::string&& name);
-	const std::string& GetName() const;
+	// Name is copied to the entity storage, returned view is valid until the name is changed or entity is destroyed
+	void SetName(std::string_view name);
+	std::string_view GetName() const;
 
 	template <typename ComponentType>
 	bool HasComponent() const
 	{
-		ComponentTypeId componentTypeId = GetComponentTypeIdByIndex(typeid(ComponentType));
+		ComponentTypeId componentTypeId = GetComponentTypeIdBySequence(detail::TypeSequenceIndex<detail::TypeFamily::Component, ComponentType>());
 		return HasComponent(componentTypeId);
 	}
 
+	template <typename TagType>
+	void AddTag()
+	{
+		AddTag(GetComponentTypeIdBySequence(detail::TypeSequenceIndex<detail::TypeFamily::Component, TagType>()));
+	}
+
+	template <typename TagType>
+	void RemoveTag()
+	{
+		RemoveTag(GetComponentTypeIdBySequence(detail::TypeSequenceIndex<detail::TypeFamily::Component, TagType>()));
+	}
+
 	template <typename ComponentType>
 	TComponentPtr<ComponentType> GetComponent() const
 	{
-		ComponentTypeId componentTypeId = GetComponentTypeIdByIndex(typeid(ComponentType));
+		ComponentTypeId componentTypeId = GetComponentTypeIdBySequence(detail::TypeSequenceIndex<detail::TypeFamily::Component, ComponentType>());
 		return static_cast<TComponentPtr<ComponentType>>(GetComponent(componentTypeId));
 	}
 
@@ -88,10 +111,12 @@ struct ECS_API Entity
 
 private:
 	ComponentTypeId GetComponentTypeIdByIndex(const std::type_index& index) const;
+	ComponentTypeId GetComponentTypeIdBySequence(const uint32_t sequenceIndex) const;
 
 	// Must be constructed only by EntitiesCollection class
 	friend class EntitiesCollection;
 	friend class EntityChildrenCollection;
+	friend class Prefab;
 
 	Entity(EntityData* data);
 
@@ -99,9 +124,75 @@ private:
 	void RemoveRef();
 
 	EntityData* GetData() const;
+	EntityColdData& GetColdData() const;
 
 private:
 	EntityData* m_data = nullptr;
 };
 
+/*
+* @brief Range of entity children. Children are accessed by index in the parent children array, so the range
+* doesn't reference hierarchy storage, and stays valid when hierarchy changes.
+*/
+class EntityChildren
+{
+public:
+	struct iterator
+	{
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = Entity;
+
+		Entity operator*() const
+		{
+			return parent->GetChildByIdx(index);
+		}
+
+		iterator& operator++()
+		{
+			++index;
+			return *this;
+		}
+
+		bool operator==(const iterator& other) const
+		{
+			return index == other.index;
+		}
+
+		bool operator!=(const iterator& other) const
+		{
+			return !(*this == other);
+		}
+
+		const Entity* parent;
+		std::size_t index;
+	};
+
+	explicit EntityChildren(const Entity& parent)
+		: m_parent(parent)
+	{}
+
+	std::size_t size() const
+	{
+		return m_parent.GetChildrenCount();
+	}
+
+	Entity operator[](const std::size_t index) const
+	{
+		return m_parent.GetChildByIdx(index);
+	}
+
+	iterator begin() const
+	{
+		return iterator{ &m_parent, 0U };
+	}
+
+	iterator end() const
+	{
+		return iterator{ &m_parent, size() };
+	}
+
+private:
+	Entity m_parent;
+};
+
 } // namespace ecs
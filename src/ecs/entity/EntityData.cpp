@@ -4,7 +4,6 @@
 namespace
 {
 const uint32_t k_invalidStorageLocation = uint32_t(-1);
-const uint16_t k_invalidOrderInParent = uint16_t(-1);
 }
 
 namespace ecs
@@ -12,28 +11,27 @@ namespace ecs
 
 EntityData::EntityData()
 	: id(Entity::GetInvalidId())
-	, parentId(Entity::GetInvalidId())
-	, orderInParent(std::numeric_limits<uint16_t>::max())
+	, storageLocation(k_invalidStorageLocation)
 	, refCount(0U)
+{}
+
+EntityData::EntityData(std::pmr::memory_resource* resource)
+	: components(resource)
+	, id(Entity::GetInvalidId())
 	, storageLocation(k_invalidStorageLocation)
+	, refCount(0U)
 {}
 
 EntityData::EntityData(EntityData&& other) noexcept
-	: id(other.id)
-	, parentId(other.parentId)
+	: componentsMask(other.componentsMask)
 	, components(std::move(other.components))
-	, orderInParent(other.orderInParent)
-	, refCount(other.refCount)
+	, id(other.id)
 	, storageLocation(other.storageLocation)
-	, children(std::move(other.children))
-	, componentsMask(other.componentsMask)
-	, name(std::move(other.name))
+	, refCount(other.refCount)
 {
 	other.id = Entity::GetInvalidId();
-	other.parentId = Entity::GetInvalidId();
 	other.refCount = 0U;
 	other.components.clear();
-	other.orderInParent = std::numeric_limits<uint16_t>::max();
 	other.storageLocation = k_invalidStorageLocation;
 	other.componentsMask.reset();
 }
@@ -41,24 +39,30 @@ EntityData::EntityData(EntityData&& other) noexcept
 EntityData& EntityData::operator=(EntityData&& other) noexcept
 {
 	id = other.id;
-	parentId = other.parentId;
 	refCount = other.refCount;
 	components = std::move(other.components);
-	orderInParent = other.orderInParent;
 	storageLocation = other.storageLocation;
-	children = std::move(other.children);
 	componentsMask = other.componentsMask;
-	name = std::move(other.name);
 
 	other.id = Entity::GetInvalidId();
-	other.parentId = Entity::GetInvalidId();
 	other.refCount = 0U;
 	other.components.clear();
 	other.componentsMask.reset();
-	other.orderInParent = std::numeric_limits<uint16_t>::max();
 	other.storageLocation = k_invalidStorageLocation;
 
 	return *this;
 }
 
+EntityColdData::EntityColdData(std::pmr::memory_resource* resource)
+	: name(resource)
+{}
+
+EntityColdData& EntityColdData::operator=(EntityColdData&& other) noexcept
+{
+	// Names are swapped, as string move may keep the previous buffer, so it is released with the other data
+	name.swap(other.name);
+
+	return *this;
+}
+
 } // namespace ecs
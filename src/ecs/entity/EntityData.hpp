@@ -1,35 +1,59 @@
 #pragma once
 #include "ecs/TypeAliases.hpp"
 #include "ecs/component/ComponentPtr.hpp"
+#include "ecs/storage/SmallVector.hpp"
 
-#include <list>
 #include <vector>
 #include <memory>
+#include <memory_resource>
+#include <string>
 
 namespace ecs
 {
 
 struct Entity;
-using EntityChildrenContainer = std::list<Entity>;
-using EntityComponentsContainer = std::vector<ComponentPtr>;
+
+// Count of components, kept inside entity data before components container allocates, can be overridden by the build
+// (see ECS_ENTITY_INLINE_COMPONENTS in CMakeLists.txt). Changes layout of entity data, like components mask width.
+#ifndef ECS_ENTITY_INLINE_COMPONENTS
+#define ECS_ENTITY_INLINE_COMPONENTS 6
+#endif
+
+using EntityComponentsContainer = SmallVector<ComponentPtr, ECS_ENTITY_INLINE_COMPONENTS>;
 
 /*
-* @brief EntityData is a data container, which fully describes entity, its state, components and reference counting.
+* @brief EntityData is a data container, which describes entity state, components and reference counting.
 * EntityData is created inside EntitiesCollection, and user have not access to it directly, only via Entity wrapper class.
+* It keeps only the data, which is used by component queries and handles (components mask first), name is kept
+* in EntityColdData and hierarchy in hierarchy arrays, stored by EntitiesCollection at the same location.
+* First components are kept inline, larger components containers allocate from the memory resource of the manager, owning the entity.
+* Entity owns a single component of each type, components are ordered by type id, so the component slot is the count
+* of component types with lower ids in the mask (tags are in the mask, but not in the components container).
 */
 struct EntityData
 {
-	EntityId id;
-	EntityId parentId;
 	ComponentMaskType componentsMask;
 	EntityComponentsContainer components;
-	uint16_t orderInParent;
-	uint16_t refCount;
+	EntityId id;
 	EntityHandleIndex storageLocation;
-	EntityChildrenContainer children;
-	std::unique_ptr<std::string> name;
+	uint16_t refCount;
 	bool isIteratingComponents : 1; // Indicates if the user is currently iterating components of an entity
 
+	// Returns slot of the component type in components container (slot of existing component or insertion slot)
+	std::size_t GetComponentSlot(const ComponentTypeId typeId, const ComponentMaskType& tagTypesMask) const
+	{
+		return componentsMask.CountBelow(static_cast<std::size_t>(typeId), tagTypesMask);
+	}
+
+	// Returns attached component of given type, or nullptr if entity has no such component
+	const ComponentPtr* FindComponent(const ComponentTypeId typeId, const ComponentMaskType& tagTypesMask) const
+	{
+		if (typeId < 0 || static_cast<std::size_t>(typeId) >= componentsMask.size() || !componentsMask.test(typeId) || tagTypesMask.test(typeId))
+			return nullptr;
+
+		return &components[GetComponentSlot(typeId, tagTypesMask)];
+	}
+
 	EntityData(const EntityData&) = delete;
 	EntityData& operator=(const EntityData&) = delete;
 
@@ -40,9 +64,32 @@ private:
 	friend class detail::MemoryPool<EntityData>;
 
 	EntityData();
+	explicit EntityData(std::pmr::memory_resource* resource);
 
 	EntityData(EntityData&&) noexcept;
 	EntityData& operator=(EntityData&&) noexcept;
 };
 
+/*
+* @brief Rarely accessed entity data, located by the storage location of entity data.
+* Name is allocated from the memory resource of the manager, owning the entity, as names are set for every instantiated entity.
+*/
+struct EntityColdData
+{
+	std::pmr::string name;
+
+	EntityColdData(const EntityColdData&) = delete;
+	EntityColdData& operator=(const EntityColdData&) = delete;
+
+	~EntityColdData() = default;
+
+private:
+	friend class EntitiesCollection;
+	friend class detail::MemoryPool<EntityColdData>;
+
+	explicit EntityColdData(std::pmr::memory_resource* resource);
+
+	EntityColdData& operator=(EntityColdData&&) noexcept;
+};
+
 } // namespace ecs
@@ -0,0 +1,41 @@
+#include "ecs/entity/Prefab.hpp"
+#include "ecs/Manager.hpp"
+
+namespace ecs
+{
+
+Prefab::Prefab(const Entity& source)
+	: m_nodes(Manager::Get()->GetMemoryResource())
+	, m_components(Manager::Get()->GetMemoryResource())
+{
+	if (source.IsValid())
+	{
+		RecordNode(source, k_invalidNodeIndex);
+	}
+}
+
+void Prefab::RecordNode(const Entity& entity, const uint32_t parentIndex)
+{
+	const uint32_t nodeIndex = static_cast<uint32_t>(m_nodes.size());
+	m_nodes.emplace_back(m_nodes.get_allocator().resource());
+
+	Node& node = m_nodes.back();
+	node.name = entity.GetName();
+	node.componentsMask = entity.GetData()->componentsMask;
+	node.parentIndex = parentIndex;
+	node.firstComponent = static_cast<uint32_t>(m_components.size());
+	node.componentsCount = static_cast<uint32_t>(entity.GetComponents().size());
+
+	// Entity components are ordered by type id, so copies keep the order
+	for (const ComponentPtr& component : entity.GetComponents())
+	{
+		m_components.push_back(Manager::Get()->CloneComponent(component));
+	}
+
+	for (std::size_t i = 0U; i < entity.GetChildrenCount(); ++i)
+	{
+		RecordNode(entity.GetChildByIdx(i), nodeIndex);
+	}
+}
+
+} // namespace ecs
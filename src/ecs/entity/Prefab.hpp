@@ -0,0 +1,74 @@
+#pragma once
+#include "ecs/entity/Entity.hpp"
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace ecs
+{
+
+/**
+* @brief Template of entities subtree, recorded once and instantiated many times (see Manager::Instantiate).
+*
+* Prefab keeps a node per recorded entity in depth first order, so parents precede their children and children
+* keep their order. Nodes components are copies of the source components, owned by the prefab and not attached
+* to entities, so they don't take part in entity queries, and source entities can be changed or destroyed after
+* recording. Node components are ordered by type id, the same way entity components are. Recorded prefab storage is
+* allocated from the manager memory resource.
+*/
+class Prefab
+{
+public:
+	static constexpr uint32_t k_invalidNodeIndex = uint32_t(-1);
+
+	struct Node
+	{
+		explicit Node(std::pmr::memory_resource* resource)
+			: name(resource)
+		{}
+
+		std::pmr::string name;
+		ComponentMaskType componentsMask; // Components and tags of the entity
+		uint32_t parentIndex = k_invalidNodeIndex;
+		uint32_t firstComponent = 0U; // Start of the node components in prefab components array
+		uint32_t componentsCount = 0U;
+	};
+
+	Prefab() = default;
+
+	// Records source entity and all its descendants
+	ECS_API explicit Prefab(const Entity& source);
+
+	// Copy is disabled, as prefab owns its components
+	Prefab(const Prefab&) = delete;
+	Prefab& operator=(const Prefab&) = delete;
+
+	// Move is available
+	Prefab(Prefab&&) = default;
+	Prefab& operator=(Prefab&&) = default;
+
+	bool IsValid() const
+	{
+		return !m_nodes.empty();
+	}
+
+	const std::pmr::vector<Node>& GetNodes() const
+	{
+		return m_nodes;
+	}
+
+	const std::pmr::vector<ComponentPtr>& GetComponents() const
+	{
+		return m_components;
+	}
+
+private:
+	void RecordNode(const Entity& entity, const uint32_t parentIndex);
+
+private:
+	std::pmr::vector<Node> m_nodes;
+	std::pmr::vector<ComponentPtr> m_components;
+};
+
+} // namespace ecs
@@ -0,0 +1,171 @@
+#include "ecs/storage/AllocationPolicy.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+const std::size_t k_hugePageSize = 2U * 1024U * 1024U;
+const std::size_t k_defaultPageSize = 4096U;
+
+std::size_t AlignUp(const std::size_t value, const std::size_t alignment)
+{
+	return (value + alignment - 1U) / alignment * alignment;
+}
+
+std::size_t GetSystemPageSize()
+{
+#if defined(_WIN32)
+	SYSTEM_INFO systemInfo;
+	GetSystemInfo(&systemInfo);
+	return static_cast<std::size_t>(systemInfo.dwPageSize);
+#elif defined(__linux__)
+	const long pageSize = sysconf(_SC_PAGESIZE);
+	return (pageSize > 0) ? static_cast<std::size_t>(pageSize) : k_defaultPageSize;
+#else
+	return k_defaultPageSize;
+#endif
+}
+
+// Huge pages are used only for blocks, which cover at least a single huge page
+bool IsHugePageBlock(const ecs::AllocationPolicy& policy, const std::size_t size)
+{
+	return policy.useHugePages && size >= k_hugePageSize;
+}
+
+void* AllocateHugePages(const std::size_t size)
+{
+#if defined(_WIN32)
+	// Large pages require lock memory privilege, so regular pages are used when large pages allocation fails
+	const SIZE_T largePageSize = GetLargePageMinimum();
+	void* memory = nullptr;
+	if (largePageSize > 0U)
+	{
+		memory = VirtualAlloc(nullptr, AlignUp(size, largePageSize), MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+	}
+
+	if (nullptr == memory)
+	{
+		memory = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	}
+
+	return memory;
+#elif defined(__linux__)
+	// Mapping is over-allocated by a huge page and trimmed, so transparent huge pages can back the whole block
+	const std::size_t mappedSize = size + k_hugePageSize;
+	void* mapping = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (MAP_FAILED == mapping)
+		return nullptr;
+
+	uint8_t* mappingStart = static_cast<uint8_t*>(mapping);
+	uint8_t* blockStart = reinterpret_cast<uint8_t*>(AlignUp(reinterpret_cast<std::uintptr_t>(mappingStart), k_hugePageSize));
+	const std::size_t headSize = static_cast<std::size_t>(blockStart - mappingStart);
+	const std::size_t tailSize = mappedSize - headSize - size;
+
+	if (headSize > 0U)
+	{
+		munmap(mappingStart, headSize);
+	}
+
+	if (tailSize > 0U)
+	{
+		munmap(blockStart + size, tailSize);
+	}
+
+	madvise(blockStart, size, MADV_HUGEPAGE);
+
+	return blockStart;
+#else
+	return ::operator new(size, std::align_val_t(k_defaultPageSize), std::nothrow);
+#endif
+}
+
+void FreeHugePages(void* memory, const std::size_t size)
+{
+#if defined(_WIN32)
+	VirtualFree(memory, 0U, MEM_RELEASE);
+#elif defined(__linux__)
+	munmap(memory, size);
+#else
+	::operator delete(memory, std::align_val_t(k_defaultPageSize));
+#endif
+}
+}
+
+namespace ecs
+{
+namespace detail
+{
+
+std::size_t GetPageSize(const AllocationPolicy& policy)
+{
+	static const std::size_t k_systemPageSize = GetSystemPageSize();
+	return policy.useHugePages ? k_hugePageSize : k_systemPageSize;
+}
+
+std::size_t GetChunkBytes(const AllocationPolicy& policy, const std::size_t itemSize)
+{
+	const std::size_t minChunkBytes = std::max(policy.minChunkBytes, itemSize);
+	return AlignUp(minChunkBytes, GetPageSize(policy));
+}
+
+void* AllocateMemory(const AllocationPolicy& policy, const std::size_t size, const std::size_t alignment)
+{
+	const std::size_t blockAlignment = std::max(policy.alignment, alignment);
+
+	if (nullptr != policy.resource)
+	{
+		return policy.resource->allocate(size, blockAlignment);
+	}
+
+	if (IsHugePageBlock(policy, size))
+	{
+		// Blocks are aligned at least to the system page size
+		assert(blockAlignment <= GetSystemPageSize());
+
+		void* memory = AllocateHugePages(AlignUp(size, GetSystemPageSize()));
+		if (nullptr == memory)
+			throw std::bad_alloc();
+
+		return memory;
+	}
+
+	return ::operator new(size, std::align_val_t(blockAlignment));
+}
+
+void FreeMemory(const AllocationPolicy& policy, void* memory, const std::size_t size, const std::size_t alignment)
+{
+	if (nullptr == memory)
+		return;
+
+	if (nullptr != policy.resource)
+	{
+		policy.resource->deallocate(memory, size, std::max(policy.alignment, alignment));
+	}
+	else if (IsHugePageBlock(policy, size))
+	{
+		FreeHugePages(memory, AlignUp(size, GetSystemPageSize()));
+	}
+	else
+	{
+		::operator delete(memory, std::align_val_t(std::max(policy.alignment, alignment)));
+	}
+}
+
+} // namespace detail
+} // namespace ecs
@@ -0,0 +1,49 @@
+#pragma once
+#include "raven_ecs_export.h"
+#include <cstddef>
+#include <memory_resource>
+
+namespace ecs
+{
+
+constexpr std::size_t k_cacheLineSize = 64U;
+
+/**
+* @brief Describes how storages allocate their chunks of memory.
+*
+* Chunks are aligned to max(alignment, alignof(T)), so over-aligned (alignas) component types keep their alignment.
+* When huge pages are requested, chunks, which are at least a huge page in size, are mapped directly from the OS
+* and marked as huge page backed (mmap + MADV_HUGEPAGE on Linux, large pages VirtualAlloc on Windows), smaller blocks
+* and platforms without huge pages support fall back to regular aligned allocation.
+* When memory resource is set, chunks and storages bookkeeping containers are allocated from it instead of the global heap
+* (huge pages are then up to the resource), so a world can run on its own arena.
+*/
+struct AllocationPolicy
+{
+	std::size_t alignment = k_cacheLineSize;
+	std::size_t minChunkBytes = 64U * 1024U; // Lower bound of chunk size for storages, that derive chunk size from item size
+	bool useHugePages = false;
+	std::pmr::memory_resource* resource = nullptr; // Memory resource, which must outlive storages. Null means global heap.
+};
+
+namespace detail
+{
+
+// Returns size of pages backing chunks allocated with the policy
+ECS_API std::size_t GetPageSize(const AllocationPolicy& policy);
+
+// Returns chunk size in bytes, which is a whole number of pages and is not less than policy minimal chunk size
+ECS_API std::size_t GetChunkBytes(const AllocationPolicy& policy, const std::size_t itemSize);
+
+// Returns memory resource for containers of storages, using the policy
+inline std::pmr::memory_resource* GetMemoryResource(const AllocationPolicy& policy)
+{
+	return (nullptr != policy.resource) ? policy.resource : std::pmr::get_default_resource();
+}
+
+// Allocates memory block, which must be freed by FreeMemory with the same policy, size and alignment
+ECS_API void* AllocateMemory(const AllocationPolicy& policy, const std::size_t size, const std::size_t alignment);
+ECS_API void FreeMemory(const AllocationPolicy& policy, void* memory, const std::size_t size, const std::size_t alignment);
+
+} // namespace detail
+} // namespace ecs
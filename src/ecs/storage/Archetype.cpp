@@ -0,0 +1,151 @@
+#include "ecs/storage/Archetype.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+std::size_t AlignUp(const std::size_t offset, const std::size_t alignment)
+{
+	return (offset + alignment - 1U) / alignment * alignment;
+}
+}
+
+namespace ecs
+{
+
+Archetype::Archetype(const ComponentMaskType& mask, std::vector<ComponentTypeId>&& typeIds, std::vector<ArchetypeColumnType>&& columnTypes, const AllocationPolicy& policy)
+	: m_mask(mask)
+	, m_policy(policy)
+	, m_typeIds(std::move(typeIds))
+	, m_chunkAlignment(policy.alignment)
+{
+	assert(m_typeIds.size() == columnTypes.size());
+
+	std::size_t rowSize = sizeof(EntityId);
+	for (const ArchetypeColumnType& columnType : columnTypes)
+	{
+		Column column;
+		column.type = columnType;
+		m_columns.push_back(column);
+
+		rowSize += sizeof(int32_t) + columnType.size;
+		m_chunkAlignment = std::max(m_chunkAlignment, columnType.alignment);
+	}
+
+	// Fit as many rows as possible into a chunk, taking columns alignment padding into account
+	m_chunkCapacity = std::max<std::size_t>(k_chunkSize / rowSize, 1U);
+	while (m_chunkCapacity > 1U && ComputeChunkLayout(m_chunkCapacity) > k_chunkSize)
+	{
+		--m_chunkCapacity;
+	}
+
+	// Chunk grows only for components, which don't fit a single row into default chunk
+	m_chunkBytes = AlignUp(std::max(ComputeChunkLayout(m_chunkCapacity), k_chunkSize), m_chunkAlignment);
+}
+
+Archetype::~Archetype()
+{
+	for (std::size_t column = 0U; column < m_columns.size(); ++column)
+	{
+		if (nullptr != m_columns[column].type.destroy)
+		{
+			for (std::size_t row = 0U; row < m_size; ++row)
+			{
+				DestroyComponent(column, row);
+			}
+		}
+	}
+}
+
+std::size_t Archetype::AllocateRow(const EntityId entityId)
+{
+	if (m_size == m_chunks.size() * m_chunkCapacity)
+	{
+		uint8_t* memory = static_cast<uint8_t*>(detail::AllocateMemory(m_policy, m_chunkBytes, m_chunkAlignment));
+		m_chunks.emplace_back(memory, ChunkDeleter{ this });
+	}
+
+	const std::size_t row = m_size++;
+	GetChunkEntities(row / m_chunkCapacity)[row % m_chunkCapacity] = entityId;
+
+	return row;
+}
+
+bool Archetype::RemoveRow(const std::size_t row)
+{
+	assert(row < m_size);
+
+	const std::size_t lastRow = --m_size;
+	const bool isLastRowMoved = (row != lastRow);
+
+	if (isLastRowMoved)
+	{
+		GetChunkEntities(row / m_chunkCapacity)[row % m_chunkCapacity] = GetEntity(lastRow);
+
+		for (std::size_t column = 0U; column < m_columns.size(); ++column)
+		{
+			RelocateColumnData(m_columns[column], GetComponentData(column, row), GetComponentData(column, lastRow));
+			GetHandleSlot(column, row) = GetHandleSlot(column, lastRow);
+		}
+	}
+
+	// Release trailing chunk when more than a chunk and a half is unused, so rows count oscillation at chunk boundary doesn't reallocate
+	if (m_chunks.size() * m_chunkCapacity - m_size >= m_chunkCapacity + m_chunkCapacity / 2U)
+	{
+		m_chunks.pop_back();
+	}
+
+	return isLastRowMoved;
+}
+
+void Archetype::RelocateComponent(const std::size_t column, const std::size_t row, Archetype& target, const std::size_t targetColumn, const std::size_t targetRow)
+{
+	assert(m_typeIds[column] == target.m_typeIds[targetColumn]);
+
+	RelocateColumnData(m_columns[column], target.GetComponentData(targetColumn, targetRow), GetComponentData(column, row));
+	target.GetHandleSlot(targetColumn, targetRow) = GetHandleSlot(column, row);
+}
+
+void Archetype::DestroyComponent(const std::size_t column, const std::size_t row)
+{
+	if (nullptr != m_columns[column].type.destroy)
+	{
+		m_columns[column].type.destroy(GetComponentData(column, row));
+	}
+}
+
+std::size_t Archetype::ReleaseUnusedChunks()
+{
+	const std::size_t usedChunksCount = (m_size + m_chunkCapacity - 1U) / m_chunkCapacity;
+	const std::size_t releasedCount = m_chunks.size() - usedChunksCount;
+
+	m_chunks.erase(m_chunks.begin() + usedChunksCount, m_chunks.end());
+	m_chunks.shrink_to_fit();
+
+	return releasedCount;
+}
+
+std::size_t Archetype::ComputeChunkLayout(const std::size_t capacity)
+{
+	// Chunk starts with entity ids array, followed by handle slots arrays, and components arrays
+	std::size_t offset = capacity * sizeof(EntityId);
+
+	for (Column& column : m_columns)
+	{
+		offset = AlignUp(offset, alignof(int32_t));
+		column.slotsOffset = offset;
+		offset += capacity * sizeof(int32_t);
+	}
+
+	for (Column& column : m_columns)
+	{
+		offset = AlignUp(offset, column.type.alignment);
+		column.dataOffset = offset;
+		offset += capacity * column.type.size;
+	}
+
+	return offset;
+}
+
+} // namespace ecs
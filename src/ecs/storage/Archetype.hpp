@@ -0,0 +1,226 @@
+#pragma once
+#include "raven_ecs_export.h"
+#include "ecs/TypeAliases.hpp"
+#include "ecs/storage/AllocationPolicy.hpp"
+#include "ecs/detail/Relocate.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace ecs
+{
+
+/**
+* @brief Type erased description of component type, stored in archetype columns
+*/
+struct ArchetypeColumnType
+{
+	// Move constructs object at destination from source, and destroys source object
+	using RelocateFunction = void(*)(void* destination, void* source);
+	using DestroyFunction = void(*)(void* object);
+
+	std::size_t size = 0U;
+	std::size_t alignment = 0U;
+	RelocateFunction relocate = nullptr; // Null for trivially relocatable types, which are relocated by copying bytes
+	DestroyFunction destroy = nullptr; // Null for trivially destructible types
+
+	template <typename T>
+	static ArchetypeColumnType Create()
+	{
+		ArchetypeColumnType columnType;
+		columnType.size = sizeof(T);
+		columnType.alignment = alignof(T);
+		columnType.relocate = IsTriviallyRelocatable<T>::value ? nullptr : &RelocateObject<T>;
+		columnType.destroy = std::is_trivially_destructible<T>::value ? nullptr : &DestroyObject<T>;
+
+		return columnType;
+	}
+
+private:
+	template <typename T>
+	static void RelocateObject(void* destination, void* source)
+	{
+		detail::RelocateAt(static_cast<T*>(destination), static_cast<T*>(source));
+	}
+
+	template <typename T>
+	static void DestroyObject(void* object)
+	{
+		static_cast<T*>(object)->~T();
+	}
+};
+
+/**
+* @brief Storage for entities sharing the same set of archetype stored component types.
+*
+* Rows are kept in fixed size chunks, each chunk holds a column per component type (structure of arrays),
+* so systems can iterate chunks linearly. Every row keeps owning entity id, and for every column the handle
+* slot of the stored component, which lets the storage patch component locations when rows move.
+* Rows are packed: removal moves the last row into the removed one.
+*/
+class Archetype
+{
+	struct ChunkDeleter
+	{
+		const Archetype* archetype;
+
+		void operator()(uint8_t* memory) const
+		{
+			detail::FreeMemory(archetype->m_policy, memory, archetype->m_chunkBytes, archetype->m_chunkAlignment);
+		}
+	};
+
+	using ChunkPtr = std::unique_ptr<uint8_t[], ChunkDeleter>;
+
+public:
+	static constexpr std::size_t k_chunkSize = 16U * 1024U;
+	static constexpr std::size_t k_invalidColumn = std::size_t(-1);
+
+	ECS_API Archetype(const ComponentMaskType& mask, std::vector<ComponentTypeId>&& typeIds, std::vector<ArchetypeColumnType>&& columnTypes, const AllocationPolicy& policy);
+	ECS_API ~Archetype();
+
+	Archetype(const Archetype&) = delete;
+	Archetype& operator=(const Archetype&) = delete;
+
+	// Appends row with uninitialized columns, which must be filled by caller, and returns its index
+	std::size_t ECS_API AllocateRow(const EntityId entityId);
+
+	/**
+	* @brief Removes row, which columns must already be relocated or destroyed, moving the last row into its place
+	* @return True if the last row has been moved into removed row
+	*/
+	bool ECS_API RemoveRow(const std::size_t row);
+
+	// Relocates component of the column from one row into another (uninitialized) row of other archetype
+	void ECS_API RelocateComponent(const std::size_t column, const std::size_t row, Archetype& target, const std::size_t targetColumn, const std::size_t targetRow);
+	void ECS_API DestroyComponent(const std::size_t column, const std::size_t row);
+
+	// Frees chunks past the last row, returning count of released chunks
+	std::size_t ECS_API ReleaseUnusedChunks();
+
+	// Returns column index of component type, or k_invalidColumn if archetype doesn't store such components
+	std::size_t GetColumnIndex(const ComponentTypeId typeId) const
+	{
+		for (std::size_t column = 0U; column < m_typeIds.size(); ++column)
+		{
+			if (m_typeIds[column] == typeId)
+				return column;
+		}
+
+		return k_invalidColumn;
+	}
+
+	void* GetComponentData(const std::size_t column, const std::size_t row) const
+	{
+		return GetChunkColumn(row / m_chunkCapacity, column) + (row % m_chunkCapacity) * m_columns[column].type.size;
+	}
+
+	int32_t& GetHandleSlot(const std::size_t column, const std::size_t row) const
+	{
+		int32_t* slots = reinterpret_cast<int32_t*>(m_chunks[row / m_chunkCapacity].get() + m_columns[column].slotsOffset);
+		return slots[row % m_chunkCapacity];
+	}
+
+	EntityId GetEntity(const std::size_t row) const
+	{
+		return GetChunkEntities(row / m_chunkCapacity)[row % m_chunkCapacity];
+	}
+
+	// Chunk access for linear iteration, all chunks except the last one are full
+	std::size_t GetChunksCount() const
+	{
+		return m_chunks.size();
+	}
+
+	std::size_t GetChunkRowsCount(const std::size_t chunkIndex) const
+	{
+		const std::size_t chunkStart = chunkIndex * m_chunkCapacity;
+		return (m_size - chunkStart < m_chunkCapacity) ? m_size - chunkStart : m_chunkCapacity;
+	}
+
+	EntityId* GetChunkEntities(const std::size_t chunkIndex) const
+	{
+		return reinterpret_cast<EntityId*>(m_chunks[chunkIndex].get());
+	}
+
+	uint8_t* GetChunkColumn(const std::size_t chunkIndex, const std::size_t column) const
+	{
+		return m_chunks[chunkIndex].get() + m_columns[column].dataOffset;
+	}
+
+	std::size_t GetChunkCapacity() const
+	{
+		return m_chunkCapacity;
+	}
+
+	std::size_t GetSize() const
+	{
+		return m_size;
+	}
+
+	const ComponentMaskType& GetMask() const
+	{
+		return m_mask;
+	}
+
+	const std::vector<ComponentTypeId>& GetTypeIds() const
+	{
+		return m_typeIds;
+	}
+
+	// Cached archetype graph edges, storing archetype reached by adding or removing component type
+	Archetype* FindTransition(const ComponentTypeId typeId, const bool isAdding) const
+	{
+		const auto& transitions = isAdding ? m_addTransitions : m_removeTransitions;
+		auto it = transitions.find(typeId);
+		return (it != transitions.end()) ? it->second : nullptr;
+	}
+
+	void SetTransition(const ComponentTypeId typeId, const bool isAdding, Archetype* archetype)
+	{
+		(isAdding ? m_addTransitions : m_removeTransitions)[typeId] = archetype;
+	}
+
+private:
+	struct Column
+	{
+		ArchetypeColumnType type;
+		std::size_t slotsOffset = 0U; // Offset of handle slots array inside chunk
+		std::size_t dataOffset = 0U; // Offset of components array inside chunk
+	};
+
+	static void RelocateColumnData(const Column& column, void* destination, void* source)
+	{
+		if (nullptr != column.type.relocate)
+		{
+			column.type.relocate(destination, source);
+		}
+		else
+		{
+			std::memcpy(destination, source, column.type.size);
+		}
+	}
+
+	// Lays out chunk arrays for provided rows count, returning required chunk size
+	std::size_t ComputeChunkLayout(const std::size_t capacity);
+
+private:
+	ComponentMaskType m_mask;
+	AllocationPolicy m_policy;
+	std::vector<ComponentTypeId> m_typeIds; // Sorted type ids, parallel to m_columns
+	std::vector<Column> m_columns;
+	std::vector<ChunkPtr> m_chunks;
+	std::size_t m_chunkCapacity = 0U; // Rows count per chunk
+	std::size_t m_chunkBytes = 0U;
+	std::size_t m_chunkAlignment = 0U;
+	std::size_t m_size = 0U; // Rows count
+
+	std::unordered_map<ComponentTypeId, Archetype*> m_addTransitions;
+	std::unordered_map<ComponentTypeId, Archetype*> m_removeTransitions;
+};
+
+} // namespace ecs
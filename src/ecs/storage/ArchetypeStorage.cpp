@@ -0,0 +1,298 @@
+#include "ecs/storage/ArchetypeStorage.hpp"
+
+#include <cassert>
+#include <limits>
+
+namespace
+{
+const ecs::EntityId k_invalidEntityId = std::numeric_limits<ecs::EntityId>::max();
+}
+
+namespace ecs
+{
+
+ArchetypeStorage::ArchetypeStorage() = default;
+
+ArchetypeStorage::ArchetypeStorage(std::pmr::memory_resource* resource)
+	: m_componentLocations(resource)
+	, m_entityArchetypes(resource)
+	, m_entityRows(resource)
+{}
+
+ArchetypeStorage::~ArchetypeStorage() = default;
+
+void ArchetypeStorage::SetAllocationPolicy(const AllocationPolicy& policy)
+{
+	m_allocationPolicy = policy;
+}
+
+void ArchetypeStorage::RegisterComponentType(const ComponentTypeId typeId, const ArchetypeColumnType& columnType)
+{
+	assert(typeId >= 0 && static_cast<std::size_t>(typeId) < MaxComponentTypesCount);
+
+	if (m_componentTypes.size() <= static_cast<std::size_t>(typeId))
+	{
+		m_componentTypes.resize(typeId + 1U);
+		m_componentLocations.resize(typeId + 1U);
+	}
+
+	ComponentMaskType mask;
+	mask.set(typeId);
+
+	ComponentTypeData& typeData = m_componentTypes[typeId];
+	typeData.columnType = columnType;
+	typeData.staging = CreateArchetype(mask);
+}
+
+void* ArchetypeStorage::StageComponent(const ComponentTypeId typeId, const int32_t handleSlot)
+{
+	ComponentTypeData& typeData = m_componentTypes[typeId];
+	std::pmr::vector<ComponentLocation>& locations = m_componentLocations[typeId];
+	if (locations.size() <= static_cast<std::size_t>(handleSlot))
+	{
+		locations.resize(handleSlot + 1U);
+	}
+
+	Archetype& staging = *typeData.staging;
+	const std::size_t row = staging.AllocateRow(k_invalidEntityId);
+	staging.GetHandleSlot(0U, row) = handleSlot;
+	UpdateRowLocations(staging, row);
+
+	return staging.GetComponentData(0U, row);
+}
+
+void ArchetypeStorage::DestroyComponent(const ComponentTypeId typeId, const int32_t handleSlot)
+{
+	ComponentTypeData& typeData = m_componentTypes[typeId];
+	if (m_componentLocations[typeId][handleSlot].archetype != typeData.staging.get())
+	{
+		DetachComponent(typeId, handleSlot);
+	}
+
+	const std::size_t row = m_componentLocations[typeId][handleSlot].row;
+	typeData.staging->DestroyComponent(0U, row);
+	RemoveRow(*typeData.staging, row);
+
+	m_componentLocations[typeId][handleSlot] = ComponentLocation();
+}
+
+void ArchetypeStorage::AttachComponent(const ComponentTypeId typeId, const int32_t handleSlot, const EntityId entityId)
+{
+	ComponentTypeData& typeData = m_componentTypes[typeId];
+	const ComponentLocation location = m_componentLocations[typeId][handleSlot];
+	assert(location.archetype == typeData.staging.get());
+
+	Archetype* current = GetEntityArchetype(entityId);
+	const std::size_t currentRow = (nullptr != current) ? static_cast<std::size_t>(m_entityRows.Find(entityId)) : 0U;
+
+	// Entity can own a single archetype stored component of each type
+	assert(nullptr == current || !current->GetMask().test(typeId));
+
+	Archetype* target = nullptr;
+	if (nullptr != current)
+	{
+		target = GetTransition(current, typeId, true);
+	}
+	else
+	{
+		ComponentMaskType mask;
+		mask.set(typeId);
+		target = GetOrCreateArchetype(mask);
+	}
+
+	const std::size_t targetRow = target->AllocateRow(entityId);
+	if (nullptr != current)
+	{
+		MoveRowComponents(*current, currentRow, *target, targetRow);
+	}
+	location.archetype->RelocateComponent(location.column, location.row, *target, target->GetColumnIndex(typeId), targetRow);
+
+	SetEntityLocation(entityId, target, targetRow);
+	UpdateRowLocations(*target, targetRow);
+
+	if (nullptr != current)
+	{
+		RemoveRow(*current, currentRow);
+	}
+	RemoveRow(*location.archetype, location.row);
+}
+
+void ArchetypeStorage::DetachComponent(const ComponentTypeId typeId, const int32_t handleSlot)
+{
+	ComponentTypeData& typeData = m_componentTypes[typeId];
+	const ComponentLocation location = m_componentLocations[typeId][handleSlot];
+	Archetype& current = *location.archetype;
+	assert(&current != typeData.staging.get());
+
+	const EntityId entityId = current.GetEntity(location.row);
+
+	// Move detached component to staging
+	Archetype& staging = *typeData.staging;
+	const std::size_t stagingRow = staging.AllocateRow(k_invalidEntityId);
+	current.RelocateComponent(location.column, location.row, staging, 0U, stagingRow);
+	UpdateRowLocations(staging, stagingRow);
+
+	// Move the rest of entity components to the archetype without detached type
+	if (current.GetTypeIds().size() > 1U)
+	{
+		Archetype* target = GetTransition(&current, typeId, false);
+		const std::size_t targetRow = target->AllocateRow(entityId);
+		MoveRowComponents(current, location.row, *target, targetRow);
+
+		SetEntityLocation(entityId, target, targetRow);
+		UpdateRowLocations(*target, targetRow);
+	}
+	else
+	{
+		m_entityArchetypes.Erase(entityId);
+		m_entityRows.Erase(entityId);
+	}
+
+	RemoveRow(current, location.row);
+}
+
+Archetype* ArchetypeStorage::GetEntityArchetype(const EntityId entityId) const
+{
+	const SparseIndex::IndexType archetypeIndex = m_entityArchetypes.Find(entityId);
+	return (SparseIndex::GetInvalidIndex() != archetypeIndex) ? m_archetypes[archetypeIndex].get() : nullptr;
+}
+
+const std::vector<Archetype*>& ArchetypeStorage::FindArchetypes(const ComponentMaskType& mask)
+{
+	QueryCache& cache = m_queryCaches[mask];
+
+	for (std::size_t i = cache.checkedArchetypesCount; i < m_archetypes.size(); ++i)
+	{
+		if (m_archetypes[i]->GetMask().Contains(mask))
+		{
+			cache.archetypes.push_back(m_archetypes[i].get());
+		}
+	}
+	cache.checkedArchetypesCount = m_archetypes.size();
+
+	return cache.archetypes;
+}
+
+void ArchetypeStorage::Compact()
+{
+	for (const std::unique_ptr<Archetype>& archetype : m_archetypes)
+	{
+		archetype->ReleaseUnusedChunks();
+	}
+
+	for (const ComponentTypeData& typeData : m_componentTypes)
+	{
+		if (nullptr != typeData.staging)
+		{
+			typeData.staging->ReleaseUnusedChunks();
+		}
+	}
+}
+
+void ArchetypeStorage::Clear()
+{
+	m_queryCaches.clear();
+	m_archetypeIndexes.clear();
+	m_archetypes.clear();
+	m_componentTypes.clear();
+	m_componentLocations.clear();
+	m_entityArchetypes.Clear();
+	m_entityRows.Clear();
+}
+
+Archetype* ArchetypeStorage::GetOrCreateArchetype(const ComponentMaskType& mask)
+{
+	auto it = m_archetypeIndexes.find(mask);
+	if (it != m_archetypeIndexes.end())
+	{
+		return m_archetypes[it->second].get();
+	}
+
+	m_archetypeIndexes.emplace(mask, static_cast<int32_t>(m_archetypes.size()));
+	m_archetypes.push_back(CreateArchetype(mask));
+
+	return m_archetypes.back().get();
+}
+
+Archetype* ArchetypeStorage::GetTransition(Archetype* source, const ComponentTypeId typeId, const bool isAdding)
+{
+	Archetype* target = source->FindTransition(typeId, isAdding);
+	if (nullptr == target)
+	{
+		ComponentMaskType mask = source->GetMask();
+		mask.set(typeId, isAdding);
+
+		target = GetOrCreateArchetype(mask);
+
+		// Edges are cached in both directions, as entities usually go back and forth
+		source->SetTransition(typeId, isAdding, target);
+		target->SetTransition(typeId, !isAdding, source);
+	}
+
+	return target;
+}
+
+std::unique_ptr<Archetype> ArchetypeStorage::CreateArchetype(const ComponentMaskType& mask) const
+{
+	std::vector<ComponentTypeId> typeIds;
+	std::vector<ArchetypeColumnType> columnTypes;
+
+	for (std::size_t typeId = 0U; typeId < m_componentTypes.size(); ++typeId)
+	{
+		if (mask.test(typeId))
+		{
+			typeIds.push_back(static_cast<ComponentTypeId>(typeId));
+			columnTypes.push_back(m_componentTypes[typeId].columnType);
+		}
+	}
+
+	return std::make_unique<Archetype>(mask, std::move(typeIds), std::move(columnTypes), m_allocationPolicy);
+}
+
+void ArchetypeStorage::MoveRowComponents(Archetype& source, const std::size_t sourceRow, Archetype& target, const std::size_t targetRow)
+{
+	const std::vector<ComponentTypeId>& sourceTypeIds = source.GetTypeIds();
+	for (std::size_t column = 0U; column < sourceTypeIds.size(); ++column)
+	{
+		const std::size_t targetColumn = target.GetColumnIndex(sourceTypeIds[column]);
+		if (Archetype::k_invalidColumn != targetColumn)
+		{
+			source.RelocateComponent(column, sourceRow, target, targetColumn, targetRow);
+		}
+	}
+}
+
+void ArchetypeStorage::RemoveRow(Archetype& archetype, const std::size_t row)
+{
+	if (archetype.RemoveRow(row))
+	{
+		// Last row has been moved into removed one
+		UpdateRowLocations(archetype, row);
+	}
+}
+
+void ArchetypeStorage::SetEntityLocation(const EntityId entityId, Archetype* archetype, const std::size_t row)
+{
+	m_entityArchetypes.Set(entityId, m_archetypeIndexes[archetype->GetMask()]);
+	m_entityRows.Set(entityId, static_cast<SparseIndex::IndexType>(row));
+}
+
+void ArchetypeStorage::UpdateRowLocations(Archetype& archetype, const std::size_t row)
+{
+	const EntityId entityId = archetype.GetEntity(row);
+	if (k_invalidEntityId != entityId)
+	{
+		m_entityRows.Set(entityId, static_cast<SparseIndex::IndexType>(row));
+	}
+
+	const std::vector<ComponentTypeId>& typeIds = archetype.GetTypeIds();
+	for (std::size_t column = 0U; column < typeIds.size(); ++column)
+	{
+		ComponentLocation& location = m_componentLocations[typeIds[column]][archetype.GetHandleSlot(column, row)];
+		location.archetype = &archetype;
+		location.column = column;
+		location.row = row;
+	}
+}
+
+} // namespace ecs
@@ -0,0 +1,143 @@
+#pragma once
+#include "raven_ecs_export.h"
+#include "ecs/storage/Archetype.hpp"
+#include "ecs/storage/SparseIndex.hpp"
+
+#include <array>
+#include <memory>
+#include <memory_resource>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ecs
+{
+
+/**
+* @brief Manager owned storage of archetype stored components (see ArchetypeComponentCollection).
+*
+* Entity components of archetype stored types live together in the archetype, matching the set of these types.
+* Attaching or detaching component moves entity row into neighbour archetype, found using cached transition edges.
+* Components, which are not attached to any entity, are kept in per type staging archetypes.
+*
+* Components are addressed by handle slots (data index of component control block), storage keeps
+* per type table with current location of every handle slot, and patches it whenever rows move.
+*/
+class ArchetypeStorage
+{
+public:
+	ECS_API ArchetypeStorage();
+	// Components locations and entity indexes are allocated from provided memory resource
+	ECS_API explicit ArchetypeStorage(std::pmr::memory_resource* resource);
+	ECS_API ~ArchetypeStorage();
+
+	ArchetypeStorage(const ArchetypeStorage&) = delete;
+	ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+
+	// Policy is used for chunks of archetypes, created after this call
+	void ECS_API SetAllocationPolicy(const AllocationPolicy& policy);
+
+	void ECS_API RegisterComponentType(const ComponentTypeId typeId, const ArchetypeColumnType& columnType);
+
+	// Allocates uninitialized memory for new detached component, which must be constructed by caller
+	ECS_API void* StageComponent(const ComponentTypeId typeId, const int32_t handleSlot);
+	void ECS_API DestroyComponent(const ComponentTypeId typeId, const int32_t handleSlot);
+
+	// Moves component into the archetype of entity, moving the rest of entity components into the new archetype too
+	void ECS_API AttachComponent(const ComponentTypeId typeId, const int32_t handleSlot, const EntityId entityId);
+	// Moves component back to staging, moving the rest of entity components into the archetype without this type
+	void ECS_API DetachComponent(const ComponentTypeId typeId, const int32_t handleSlot);
+
+	void* GetComponentData(const ComponentTypeId typeId, const int32_t handleSlot) const
+	{
+		const ComponentLocation& location = m_componentLocations[typeId][handleSlot];
+		return location.archetype->GetComponentData(location.column, location.row);
+	}
+
+	// Returns entity archetype, or nullptr if entity has no archetype stored components
+	ECS_API Archetype* GetEntityArchetype(const EntityId entityId) const;
+
+	// Returns all archetypes, which contain every component type from the mask. Result is cached per mask.
+	ECS_API const std::vector<Archetype*>& FindArchetypes(const ComponentMaskType& mask);
+
+	/**
+	* @brief Invokes func(rowsCount, entities, ComponentT* columns...) for every chunk of every archetype matching the types.
+	* Components must not be attached or detached from the archetype stored types during iteration.
+	*/
+	template <class ...ComponentT, typename Func>
+	void ForEachChunk(const std::array<ComponentTypeId, sizeof...(ComponentT)>& typeIds, Func&& func)
+	{
+		ForEachChunkImpl<ComponentT...>(typeIds, func, std::index_sequence_for<ComponentT...>());
+	}
+
+	std::size_t GetArchetypesCount() const
+	{
+		return m_archetypes.size();
+	}
+
+	// Releases archetype chunks, which don't contain rows. Rows are always packed, so they don't move.
+	void ECS_API Compact();
+
+	void ECS_API Clear();
+
+private:
+	struct ComponentLocation
+	{
+		Archetype* archetype = nullptr;
+		std::size_t column = 0U;
+		std::size_t row = 0U;
+	};
+
+	struct ComponentTypeData
+	{
+		ArchetypeColumnType columnType;
+		std::unique_ptr<Archetype> staging; // Archetype, keeping components of this type, not attached to entities
+	};
+
+	struct QueryCache
+	{
+		std::vector<Archetype*> archetypes;
+		std::size_t checkedArchetypesCount = 0U; // Archetypes are only appended, so only the new ones are checked
+	};
+
+	template <class ...ComponentT, typename Func, std::size_t ...I>
+	void ForEachChunkImpl(const std::array<ComponentTypeId, sizeof...(ComponentT)>& typeIds, Func& func, std::index_sequence<I...>)
+	{
+		ComponentMaskType mask;
+		(mask.set(typeIds[I]), ...);
+
+		for (Archetype* archetype : FindArchetypes(mask))
+		{
+			const std::size_t columns[] = { archetype->GetColumnIndex(typeIds[I])... };
+
+			for (std::size_t chunk = 0U; chunk < archetype->GetChunksCount(); ++chunk)
+			{
+				func(archetype->GetChunkRowsCount(chunk), archetype->GetChunkEntities(chunk), reinterpret_cast<ComponentT*>(archetype->GetChunkColumn(chunk, columns[I]))...);
+			}
+		}
+	}
+
+	Archetype* GetOrCreateArchetype(const ComponentMaskType& mask);
+	Archetype* GetTransition(Archetype* source, const ComponentTypeId typeId, const bool isAdding);
+	std::unique_ptr<Archetype> CreateArchetype(const ComponentMaskType& mask) const;
+
+	// Relocates all source row components, which are stored in target archetype, into target row
+	void MoveRowComponents(Archetype& source, const std::size_t sourceRow, Archetype& target, const std::size_t targetRow);
+	void RemoveRow(Archetype& archetype, const std::size_t row);
+	void SetEntityLocation(const EntityId entityId, Archetype* archetype, const std::size_t row);
+	void UpdateRowLocations(Archetype& archetype, const std::size_t row);
+
+private:
+	std::vector<ComponentTypeData> m_componentTypes; // Indexed by component type id, empty for types with other storages
+	std::pmr::vector<std::pmr::vector<ComponentLocation>> m_componentLocations; // Location per handle slot, indexed by component type id
+	std::vector<std::unique_ptr<Archetype>> m_archetypes;
+	std::unordered_map<ComponentMaskType, int32_t> m_archetypeIndexes;
+	std::unordered_map<ComponentMaskType, QueryCache> m_queryCaches;
+	AllocationPolicy m_allocationPolicy;
+
+	// Entity location: archetype index and row
+	SparseIndex m_entityArchetypes;
+	SparseIndex m_entityRows;
+};
+
+} // namespace ecs
@@ -0,0 +1,118 @@
+#pragma once
+#include "ecs/detail/Types.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory_resource>
+#include <vector>
+
+namespace ecs
+{
+
+/**
+* @brief Maps lightweight component handles (slot index and generation) to control blocks of collection components.
+*
+* Slot generation is incremented when component is destroyed, so stale handles fail to resolve, while slots are reused.
+* Freed slots are reused in FIFO order, spreading reuses over all free slots, and a slot, which reached the last
+* generation, is retired, so its 16 bits generation never wraps around to a value of a stale handle.
+*/
+class ComponentHandleTable
+{
+public:
+	ComponentHandleTable() = default;
+
+	explicit ComponentHandleTable(std::pmr::memory_resource* resource)
+		: m_slots(resource)
+		, m_freeSlots(resource)
+	{}
+
+	// Assigns handle slot to the control block, writing slot index and generation into the block
+	void Register(ComponentPtrBlock& block)
+	{
+		uint32_t index = static_cast<uint32_t>(m_slots.size());
+		if (!m_freeSlots.empty())
+		{
+			index = m_freeSlots.front();
+			m_freeSlots.pop_front();
+		}
+		else
+		{
+			m_slots.push_back(Slot{ nullptr, 0U });
+		}
+
+		Slot& slot = m_slots[index];
+		slot.block = &block;
+		block.handleIndex = index;
+		block.handleGeneration = slot.generation;
+	}
+
+	std::pmr::memory_resource* GetMemoryResource() const
+	{
+		return m_slots.get_allocator().resource();
+	}
+
+	// Invalidates handles of the block, must be called before the block is destroyed
+	void Unregister(const ComponentPtrBlock& block)
+	{
+		Slot& slot = m_slots[block.handleIndex];
+		assert(slot.block == &block);
+
+		Release(slot, block.handleIndex);
+	}
+
+	// Invalidates handles of all the blocks, keeping slot generations
+	void UnregisterAll()
+	{
+		for (std::size_t index = 0U; index < m_slots.size(); ++index)
+		{
+			Slot& slot = m_slots[index];
+			if (nullptr != slot.block)
+			{
+				Release(slot, static_cast<uint32_t>(index));
+			}
+		}
+	}
+
+	// Returns control block of the handle, or nullptr if handle is stale
+	ComponentPtrBlock* Resolve(const uint32_t index, const uint16_t generation) const
+	{
+		if (index < m_slots.size())
+		{
+			const Slot& slot = m_slots[index];
+			if (slot.generation == generation)
+			{
+				return slot.block;
+			}
+		}
+
+		return nullptr;
+	}
+
+private:
+	struct Slot
+	{
+		ComponentPtrBlock* block;
+		uint16_t generation;
+	};
+
+	static constexpr uint16_t k_lastGeneration = std::numeric_limits<uint16_t>::max();
+
+	void Release(Slot& slot, const uint32_t index)
+	{
+		slot.block = nullptr;
+		++slot.generation;
+
+		// Slot, which reached the last generation, is retired, it never resolves again
+		if (slot.generation != k_lastGeneration)
+		{
+			m_freeSlots.push_back(index);
+		}
+	}
+
+	std::pmr::vector<Slot> m_slots;
+	std::pmr::deque<uint32_t> m_freeSlots;
+};
+
+} // namespace ecs
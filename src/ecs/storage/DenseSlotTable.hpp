@@ -0,0 +1,162 @@
+#pragma once
+#include "ecs/detail/Types.hpp"
+#include "ecs/storage/ObjectPool.hpp"
+#include "ecs/storage/SparseIndex.hpp"
+
+#include <cassert>
+#include <limits>
+#include <vector>
+
+namespace ecs
+{
+
+/**
+* @brief Bookkeeping part of dense (sparse set) component collections.
+*
+* Table keeps per dense slot owning entity id and control block, and maps entity ids to dense slots.
+* Component payload is stored by collection itself, and must be moved exactly as the table slots move
+* (swap and pop on removal, swaps on reordering).
+*/
+class DenseSlotTable
+{
+public:
+	DenseSlotTable() = default;
+
+	// Slots arrays, control blocks and entity index are allocated using the policy
+	explicit DenseSlotTable(const AllocationPolicy& policy)
+		: m_entities(detail::GetMemoryResource(policy))
+		, m_blockIndexes(detail::GetMemoryResource(policy))
+		, m_controlBlocks(policy)
+		, m_entityIndex(detail::GetMemoryResource(policy))
+	{}
+
+	// Appends slot for new detached component, returning its control block
+	ComponentPtrBlock& Push(const ComponentTypeId typeId)
+	{
+		const int32_t slotIndex = static_cast<int32_t>(m_entities.size());
+		auto blockInsertResult = m_controlBlocks.Emplace(typeId, slotIndex, k_invalidEntityId, 1);
+
+		m_entities.push_back(k_invalidEntityId);
+		m_blockIndexes.push_back(blockInsertResult.index);
+
+		return blockInsertResult.ref;
+	}
+
+	void Reserve(const std::size_t count)
+	{
+		m_entities.reserve(m_entities.size() + count);
+		m_blockIndexes.reserve(m_blockIndexes.size() + count);
+		m_controlBlocks.Reserve(count);
+	}
+
+	// Removes slot, moving the last slot into its place, and patching moved slot control block and entity mapping
+	void RemoveSwap(const std::size_t index)
+	{
+		assert(index < m_entities.size());
+
+		const std::size_t lastIndex = m_entities.size() - 1U;
+		const std::size_t removedBlockIndex = m_blockIndexes[index];
+
+		if (k_invalidEntityId != m_entities[index])
+		{
+			m_entityIndex.Erase(m_entities[index]);
+		}
+
+		if (index != lastIndex)
+		{
+			m_entities[index] = m_entities[lastIndex];
+			m_blockIndexes[index] = m_blockIndexes[lastIndex];
+			OnSlotMoved(index);
+		}
+
+		m_entities.pop_back();
+		m_blockIndexes.pop_back();
+		m_controlBlocks.RemoveAt(removedBlockIndex);
+	}
+
+	// Swaps two slots, patching control blocks and entity mappings of both
+	void Swap(const std::size_t leftIndex, const std::size_t rightIndex)
+	{
+		if (leftIndex == rightIndex)
+			return;
+
+		std::swap(m_entities[leftIndex], m_entities[rightIndex]);
+		std::swap(m_blockIndexes[leftIndex], m_blockIndexes[rightIndex]);
+		OnSlotMoved(leftIndex);
+		OnSlotMoved(rightIndex);
+	}
+
+	void SetEntity(const std::size_t index, const EntityId entityId)
+	{
+		if (k_invalidEntityId != m_entities[index])
+		{
+			m_entityIndex.Erase(m_entities[index]);
+		}
+
+		m_entities[index] = entityId;
+
+		if (k_invalidEntityId != entityId)
+		{
+			m_entityIndex.Set(entityId, static_cast<SparseIndex::IndexType>(index));
+		}
+	}
+
+	// Returns dense slot of the component attached to entity, or SparseIndex::GetInvalidIndex()
+	SparseIndex::IndexType FindByEntity(const EntityId entityId) const
+	{
+		return m_entityIndex.Find(entityId);
+	}
+
+	ComponentPtrBlock& GetControlBlock(const std::size_t index)
+	{
+		return m_controlBlocks.At(m_blockIndexes[index]);
+	}
+
+	const EntityId* GetEntitiesData() const
+	{
+		return m_entities.data();
+	}
+
+	std::size_t GetSize() const
+	{
+		return m_entities.size();
+	}
+
+	// Releases unused capacity of slots arrays, empty control block rooms and entity index pages
+	void Compact()
+	{
+		m_entities.shrink_to_fit();
+		m_blockIndexes.shrink_to_fit();
+		m_controlBlocks.ReleaseEmptyRooms();
+		m_entityIndex.ReleaseEmptyPages();
+	}
+
+	void Clear()
+	{
+		m_entities.clear();
+		m_blockIndexes.clear();
+		m_controlBlocks.Clear();
+		m_entityIndex.Clear();
+	}
+
+private:
+	void OnSlotMoved(const std::size_t index)
+	{
+		m_controlBlocks.At(m_blockIndexes[index]).dataIndex = static_cast<int32_t>(index);
+
+		if (k_invalidEntityId != m_entities[index])
+		{
+			m_entityIndex.Set(m_entities[index], static_cast<SparseIndex::IndexType>(index));
+		}
+	}
+
+private:
+	static constexpr EntityId k_invalidEntityId = std::numeric_limits<EntityId>::max();
+
+	std::pmr::vector<EntityId> m_entities; // Owning entity id per dense slot (invalid id for detached components)
+	std::pmr::vector<std::size_t> m_blockIndexes; // Control block pool index per dense slot
+	ObjectPool<ComponentPtrBlock> m_controlBlocks;
+	SparseIndex m_entityIndex;
+};
+
+} // namespace ecs
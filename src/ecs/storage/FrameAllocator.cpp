@@ -0,0 +1,63 @@
+#include "ecs/storage/FrameAllocator.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace ecs
+{
+
+FrameAllocator::FrameAllocator(const std::size_t blockSize, std::pmr::memory_resource* upstream)
+	: m_upstream(upstream)
+	, m_blockSize(blockSize)
+	, m_blocks(upstream)
+{
+	assert(m_blockSize > 0U);
+}
+
+FrameAllocator::~FrameAllocator()
+{
+	ReleaseBlocks();
+}
+
+void FrameAllocator::ReleaseBlocks()
+{
+	for (const Block& block : m_blocks)
+	{
+		m_upstream->deallocate(block.memory, block.size, alignof(std::max_align_t));
+	}
+
+	m_blocks.clear();
+	Reset();
+}
+
+void* FrameAllocator::AllocateFromNextBlock(const std::size_t size, const std::size_t alignment)
+{
+	// Blocks, which were allocated during previous frames, are reused first
+	while (m_nextBlock < m_blocks.size())
+	{
+		const Block& block = m_blocks[m_nextBlock++];
+		m_current = reinterpret_cast<std::uintptr_t>(block.memory);
+		m_currentEnd = m_current + block.size;
+
+		const std::uintptr_t address = (m_current + alignment - 1U) & ~std::uintptr_t(alignment - 1U);
+		if (address + size <= m_currentEnd)
+		{
+			m_current = address + size;
+			return reinterpret_cast<void*>(address);
+		}
+	}
+
+	// Frame needs more memory than before, oversized allocations get a block of their own size
+	const std::size_t blockSize = std::max(m_blockSize, size + alignment);
+	Block block{ static_cast<std::byte*>(m_upstream->allocate(blockSize, alignof(std::max_align_t))), blockSize };
+	m_blocks.push_back(block);
+	m_nextBlock = m_blocks.size();
+
+	const std::uintptr_t address = (reinterpret_cast<std::uintptr_t>(block.memory) + alignment - 1U) & ~std::uintptr_t(alignment - 1U);
+	m_current = address + size;
+	m_currentEnd = reinterpret_cast<std::uintptr_t>(block.memory) + blockSize;
+
+	return reinterpret_cast<void*>(address);
+}
+
+} // namespace ecs
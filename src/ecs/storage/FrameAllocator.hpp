@@ -0,0 +1,150 @@
+#pragma once
+#include "raven_ecs_export.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace ecs
+{
+
+/**
+* @brief Linear (bump) allocator for temporary data, which lives until the end of current manager update.
+*
+* Allocation advances offset inside the current block, deallocation does nothing, and Reset rewinds allocator
+* to the first block in O(1), keeping the blocks for the next frame. Blocks are requested from upstream resource
+* only when the frame needs more memory than before, so in steady state frames don't allocate at all.
+* Allocator is a memory resource, so it can back std::pmr containers, or STL containers using FrameStlAllocator.
+* Allocator is not thread safe, manager keeps a separate allocator per worker thread.
+*/
+class FrameAllocator
+	: public std::pmr::memory_resource
+{
+public:
+	static constexpr std::size_t k_defaultBlockSize = 256U * 1024U;
+
+	ECS_API explicit FrameAllocator(const std::size_t blockSize = k_defaultBlockSize, std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+	ECS_API ~FrameAllocator() override;
+
+	FrameAllocator(const FrameAllocator&) = delete;
+	FrameAllocator& operator=(const FrameAllocator&) = delete;
+
+	// Alignment must be a power of two
+	void* Allocate(const std::size_t size, const std::size_t alignment = alignof(std::max_align_t))
+	{
+		const std::uintptr_t address = (m_current + alignment - 1U) & ~std::uintptr_t(alignment - 1U);
+		if (address + size <= m_currentEnd)
+		{
+			m_current = address + size;
+			return reinterpret_cast<void*>(address);
+		}
+
+		return AllocateFromNextBlock(size, alignment);
+	}
+
+	// Allocates uninitialized array, objects must be trivially destructible or destroyed by caller
+	template <typename T>
+	T* AllocateArray(const std::size_t count)
+	{
+		return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+	}
+
+	// Invalidates all the allocations made since the previous reset
+	void Reset()
+	{
+		m_nextBlock = 0U;
+		m_current = 0U;
+		m_currentEnd = 0U;
+	}
+
+	// Returns all the blocks to upstream resource, invalidating all the allocations
+	void ECS_API ReleaseBlocks();
+
+	std::size_t GetBlocksCount() const
+	{
+		return m_blocks.size();
+	}
+
+private:
+	struct Block
+	{
+		std::byte* memory;
+		std::size_t size;
+	};
+
+	ECS_API void* AllocateFromNextBlock(const std::size_t size, const std::size_t alignment);
+
+	void* do_allocate(const std::size_t size, const std::size_t alignment) override
+	{
+		return Allocate(size, alignment);
+	}
+
+	void do_deallocate(void*, const std::size_t, const std::size_t) override
+	{}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+	{
+		return this == &other;
+	}
+
+private:
+	std::pmr::memory_resource* m_upstream;
+	std::size_t m_blockSize;
+	std::pmr::vector<Block> m_blocks;
+	std::size_t m_nextBlock = 0U; // Index of the block, which is used when current block is exhausted
+	std::uintptr_t m_current = 0U; // Free space of the current block
+	std::uintptr_t m_currentEnd = 0U;
+};
+
+/**
+* @brief STL allocator adaptor, allocating from frame allocator without virtual calls. Deallocation does nothing.
+*/
+template <typename T>
+class FrameStlAllocator
+{
+public:
+	using value_type = T;
+
+	FrameStlAllocator(FrameAllocator& frameAllocator) noexcept
+		: m_frameAllocator(&frameAllocator)
+	{}
+
+	template <typename U>
+	FrameStlAllocator(const FrameStlAllocator<U>& other) noexcept
+		: m_frameAllocator(other.GetFrameAllocator())
+	{}
+
+	T* allocate(const std::size_t count)
+	{
+		return m_frameAllocator->AllocateArray<T>(count);
+	}
+
+	void deallocate(T*, const std::size_t) noexcept
+	{}
+
+	FrameAllocator* GetFrameAllocator() const noexcept
+	{
+		return m_frameAllocator;
+	}
+
+	template <typename U>
+	bool operator==(const FrameStlAllocator<U>& other) const noexcept
+	{
+		return m_frameAllocator == other.GetFrameAllocator();
+	}
+
+	template <typename U>
+	bool operator!=(const FrameStlAllocator<U>& other) const noexcept
+	{
+		return !(*this == other);
+	}
+
+private:
+	FrameAllocator* m_frameAllocator;
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+
+} // namespace ecs
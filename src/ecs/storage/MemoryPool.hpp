@@ -1,8 +1,11 @@
 #pragma once
+#include <algorithm>
 #include <cassert>
-#include <cstdlib>
 #include <utility>
 #include <iterator>
+#include <vector>
+#include "ecs/storage/AllocationPolicy.hpp"
+#include "ecs/detail/Relocate.hpp"
 
 namespace ecs
 {
@@ -13,24 +16,41 @@ namespace detail
 * @brief Memory pool is an unordered objects collection with random access
 *
 * When the object is destroyed, iterator to the end element and destroyed element are invalidated.
+* Chunks are allocated using allocation policy, and are aligned to max(policy alignment, alignof(T)).
 */
 template <class T>
 class MemoryPool
 {
 public:
 	MemoryPool() = delete;
-	MemoryPool(const std::size_t chunkSize)
-		: m_chunkSize(chunkSize)
+	MemoryPool(const std::size_t chunkSize, const AllocationPolicy& policy = AllocationPolicy())
+		: m_policy(policy)
+		, m_chunkSize(chunkSize)
+		, m_chunkBytes(chunkSize * sizeof(T))
+		, m_chunks(GetMemoryResource(policy))
 	{
 		assert(m_chunkSize > 16U);
 	}
+
+	// Chunk size is derived from item size, so every chunk occupies a whole number of pages
+	MemoryPool(const AllocationPolicy& policy)
+		: m_policy(policy)
+		, m_chunkSize(GetChunkBytes(policy, sizeof(T)) / sizeof(T))
+		, m_chunkBytes(GetChunkBytes(policy, sizeof(T)))
+		, m_chunks(GetMemoryResource(policy))
+	{}
+
+	// Pool owns its chunks, so it can't be copied
+	MemoryPool(const MemoryPool&) = delete;
+	MemoryPool& operator=(const MemoryPool&) = delete;
+
 	~MemoryPool()
 	{
 		Clear();
 
-		if (nullptr != m_chunks)
+		for (T* chunk : m_chunks)
 		{
-			free(m_chunks);
+			FreeMemory(m_policy, chunk, m_chunkBytes, alignof(T));
 		}
 	}
 
@@ -83,21 +103,22 @@ public:
 	};
 
 	using CreationResult = std::pair<std::size_t, T*>;
-	CreationResult CreateItem()
+	template <typename ...Args>
+	CreationResult CreateItem(Args&&... args)
 	{
 		auto poolLocation = GetPoolLocation(m_usedSpace);
 
-		if (poolLocation.first >= m_chunksCount)
+		if (poolLocation.first >= m_chunks.size())
 		{
 			AllocateNewChunk();
 		}
 
-		assert(poolLocation.first < m_chunksCount);
+		assert(poolLocation.first < m_chunks.size());
 		auto createdIndex = m_usedSpace;
 		++m_usedSpace;
 		CreationResult result = { createdIndex, GetItem(createdIndex) };
 
-		new (result.second) T();
+		new (result.second) T(std::forward<Args>(args)...);
 		
 		return result;
 	}
@@ -107,18 +128,14 @@ public:
 	{
 		assert(index < m_usedSpace && m_usedSpace > 0U);
 
-		auto destroyPoolLocation = GetPoolLocation(index);
-		auto lastPoolLocation = GetPoolLocation(m_usedSpace - 1);
+		T* destroyedItem = GetItem(index);
+		DestroyAt(destroyedItem);
 
-		// Call object destructor
-		T& destroyedItem = m_chunks[destroyPoolLocation.first][destroyPoolLocation.second];
-		destroyedItem.~T();
-
-		// If destroyed element is not the last, move last item to destroyed element location
-		if (destroyPoolLocation.first != lastPoolLocation.first || destroyPoolLocation.second != lastPoolLocation.second)
+		// If destroyed element is not the last, relocate last item into destroyed element location
+		const std::size_t lastIndex = m_usedSpace - 1U;
+		if (index != lastIndex)
 		{
-			T& lastItem = m_chunks[lastPoolLocation.first][lastPoolLocation.second];
-			destroyedItem = std::move(lastItem);
+			RelocateAt(destroyedItem, GetItem(lastIndex));
 		}
 
 		--m_usedSpace;
@@ -126,6 +143,25 @@ public:
 		return { iterator(this, index), end() };
 	}
 
+	// Destroys items range [index, index + count), filling the gap with items from the pool tail
+	void DestroyItems(const std::size_t index, const std::size_t count)
+	{
+		assert(index + count <= m_usedSpace);
+
+		for (std::size_t i = 0U; i < count;)
+		{
+			const std::size_t runLength = GetContiguousRunLength(index + i, count - i);
+			DestroyRange(GetItem(index + i), runLength);
+			i += runLength;
+		}
+
+		const std::size_t tailCount = m_usedSpace - index - count;
+		const std::size_t relocatedCount = std::min(count, tailCount);
+		RelocateItems(index, m_usedSpace - relocatedCount, relocatedCount);
+
+		m_usedSpace -= count;
+	}
+
 	T* GetItem(const std::size_t index) const
 	{
 		assert(index < m_usedSpace);
@@ -142,19 +178,37 @@ public:
 	void Clear()
 	{
 		// Call alive objects destructors
-		for (std::size_t i = 0U; i < m_usedSpace; ++i)
+		if constexpr (!std::is_trivially_destructible<T>::value)
 		{
-			auto location = GetPoolLocation(i);
-			T& objectRef = m_chunks[location.first][location.second];
-			objectRef.~T();
+			for (std::size_t i = 0U; i < m_usedSpace; ++i)
+			{
+				GetItem(i)->~T();
+			}
 		}
 
 		m_usedSpace = 0U;
 	}
 
+	// Frees chunks, which don't contain alive items, returning count of released chunks
+	std::size_t ReleaseUnusedChunks()
+	{
+		const std::size_t usedChunksCount = (m_usedSpace + m_chunkSize - 1U) / m_chunkSize;
+		const std::size_t releasedCount = m_chunks.size() - usedChunksCount;
+
+		for (std::size_t i = usedChunksCount; i < m_chunks.size(); ++i)
+		{
+			FreeMemory(m_policy, m_chunks[i], m_chunkBytes, alignof(T));
+		}
+
+		m_chunks.resize(usedChunksCount);
+		m_chunks.shrink_to_fit();
+
+		return releasedCount;
+	}
+
 	std::size_t GetAllocatedCount() const
 	{
-		return m_chunksCount * m_chunkSize;
+		return m_chunks.size() * m_chunkSize;
 	}
 
 	iterator begin()
@@ -179,7 +233,7 @@ public:
 			--m_usedSpace;
 
 			auto location = GetPoolLocation(m_usedSpace);
-			m_chunks[location.first][location.second].~T();
+			DestroyAt(&m_chunks[location.first][location.second]);
 		}
 	}
 
@@ -202,26 +256,30 @@ public:
 private:
 	void AllocateNewChunk()
 	{
-		Chunk newChunk = reinterpret_cast<Chunk>(malloc(m_chunkSize * sizeof(T)));
+		Chunk newChunk = reinterpret_cast<Chunk>(AllocateMemory(m_policy, m_chunkBytes, alignof(T)));
 		assert(nullptr != newChunk);
 
-		++m_chunksCount;
+		// Assign new chunk pointer to the end of the list
+		m_chunks.push_back(newChunk);
+	}
+	
+	// Returns count of items, starting from index, that lay contiguously in the same chunk (up to maxCount)
+	std::size_t GetContiguousRunLength(const std::size_t index, const std::size_t maxCount) const
+	{
+		return std::min(maxCount, m_chunkSize - index % m_chunkSize);
+	}
 
-		if (nullptr != m_chunks)
-		{
-			m_chunks = reinterpret_cast<Chunk*>(realloc(m_chunks, m_chunksCount * sizeof(Chunk)));
-		}
-		else
+	// Relocates items to uninitialized locations, copying contiguous runs at once for trivially relocatable types
+	void RelocateItems(const std::size_t destinationIndex, const std::size_t sourceIndex, const std::size_t count)
+	{
+		for (std::size_t i = 0U; i < count;)
 		{
-			m_chunks = reinterpret_cast<Chunk*>(malloc(m_chunksCount * sizeof(Chunk)));
+			const std::size_t runLength = std::min(GetContiguousRunLength(destinationIndex + i, count - i), GetContiguousRunLength(sourceIndex + i, count - i));
+			RelocateRange(&m_chunks[(destinationIndex + i) / m_chunkSize][(destinationIndex + i) % m_chunkSize], &m_chunks[(sourceIndex + i) / m_chunkSize][(sourceIndex + i) % m_chunkSize], runLength);
+			i += runLength;
 		}
-
-		assert(nullptr != m_chunks);
-
-		// Assign new chunk pointer to the end of the list
-		m_chunks[m_chunksCount - 1U] = newChunk;
 	}
-	
+
 	using PoolLocation = std::pair<std::size_t, std::size_t>;
 	PoolLocation GetPoolLocation(const std::size_t index) const
 	{
@@ -229,11 +287,12 @@ private:
 	}
 
 private:
-	const std::size_t m_chunkSize = 1024U;
+	const AllocationPolicy m_policy;
+	const std::size_t m_chunkSize = 1024U; // Items count per chunk
+	const std::size_t m_chunkBytes;
 	std::size_t m_usedSpace = 0U;
-	std::size_t m_chunksCount = 0U;
 	using Chunk = T*;
-	Chunk* m_chunks = nullptr;
+	std::pmr::vector<Chunk> m_chunks; // Chunks table, allocated from policy memory resource
 };
 
 } // namespace detail
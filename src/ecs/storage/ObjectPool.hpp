@@ -1,10 +1,13 @@
 #pragma once
 #include <cassert>
 #include <iterator>
-#include <list>
+#include <memory>
 #include <vector>
-#include <unordered_set>
-#include <bitset>
+#include <limits>
+#include <type_traits>
+#include "ecs/detail/Bits.hpp"
+#include "ecs/detail/Construct.hpp"
+#include "ecs/storage/AllocationPolicy.hpp"
 
 namespace ecs
 {
@@ -12,28 +15,55 @@ namespace ecs
 template <class T, std::size_t RoomSize = 32U>
 class ObjectPool
 {
-	using PoolType = ObjectPool<T>;
+	using PoolType = ObjectPool<T, RoomSize>;
 
 public:
 	class TRoom
 	{
 		friend class ObjectPool<T, RoomSize>;
 
+		static constexpr std::size_t k_maskWordsCount = detail::GetBitWordsCount(RoomSize);
+
 	public:
 		TRoom(int32_t inRoomIndex)
 			: roomIndex(inRoomIndex)
 		{}
 
-		~TRoom() = default;
+		TRoom(const TRoom& other)
+			: roomIndex(other.roomIndex)
+			, size(other.size)
+			, firstFreePosition(other.firstFreePosition)
+		{
+			for (std::size_t i = other._GetFilledPosition(0U); i < RoomSize; i = other._GetFilledPosition(i + 1U))
+			{
+				new (&items[i]) T(other.GetConst(i));
+				detail::SetBit(filledPositions, i);
+			}
+		}
+
+		TRoom& operator=(const TRoom&) = delete;
+
+		~TRoom()
+		{
+			if (!std::is_trivially_destructible<T>::value)
+			{
+				for (std::size_t i = _GetFilledPosition(0U); i < RoomSize; i = _GetFilledPosition(i + 1U))
+				{
+					GetMutable(i).~T();
+				}
+			}
+		}
 
+		// Constructs item in place from provided arguments
 		template <typename ...Args>
 		std::size_t Emplace(Args&&... args)
 		{
-			std::size_t insertPos = _GetEmptyPosition(0U);
+			std::size_t insertPos = _GetEmptyPosition(firstFreePosition);
 			assert(insertPos < RoomSize);
 
-			items[insertPos] = T(std::forward<Args>(args)...);
-			filledPositions.set(insertPos);
+			detail::ConstructAt<T>(&items[insertPos], std::forward<Args>(args)...);
+			detail::SetBit(filledPositions, insertPos);
+			firstFreePosition = insertPos + 1U;
 			++size;
 
 			return insertPos;
@@ -41,80 +71,83 @@ public:
 
 		std::size_t Push(const T& object)
 		{
-			std::size_t insertPos = _GetEmptyPosition(0U);
-			assert(insertPos < RoomSize);
-
-			items[insertPos] = T(object);
-			filledPositions.set(insertPos);
-			++size;
-
-			return insertPos;
+			return Emplace(object);
 		}
 
 		std::size_t Push(T&& object)
 		{
-			std::size_t insertPos = _GetEmptyPosition(0U);
-			assert(insertPos < RoomSize);
-
-			items[insertPos] = T(object);
-			filledPositions.set(std::move(insertPos));
-			++size;
-
-			return insertPos;
+			return Emplace(std::move(object));
 		}
 
 		T& GetMutable(const std::size_t index)
 		{
-			return items[index];
+			return *reinterpret_cast<T*>(&items[index]);
 		}
 
 		const T& GetConst(const std::size_t index) const
 		{
-			return items[index];
+			return *reinterpret_cast<const T*>(&items[index]);
 		}
 
+		// Destroys item, leaving its slot uninitialized
 		void Remove(const std::size_t index)
 		{
-			assert(filledPositions.test(index));
+			assert(IsFilled(index));
 
-			items[index] = T();
-			filledPositions.reset(index);
+			GetMutable(index).~T();
+			detail::ResetBit(filledPositions, index);
 			--size;
-		}
 
-		std::size_t _GetEmptyPosition(const std::size_t startPos) const
-		{
-			for (std::size_t i = startPos; i < RoomSize; ++i)
+			if (index < firstFreePosition)
 			{
-				if (!filledPositions.test(i))
-					return i;
+				firstFreePosition = index;
 			}
+		}
 
-			return RoomSize;
+		bool IsFilled(const std::size_t index) const
+		{
+			return detail::TestBit(filledPositions, index);
 		}
 
-		std::size_t _GetFilledPosition(const std::size_t startPos) const
+		// Returns first free position >= startPos, or RoomSize if there is no free position
+		std::size_t _GetEmptyPosition(const std::size_t startPos) const
 		{
-			for (std::size_t i = startPos; i < RoomSize; ++i)
-			{
-				if (filledPositions.test(i))
-					return i;
-			}
+			std::size_t position = detail::FindNextClearBit(filledPositions, k_maskWordsCount, startPos);
+			return position < RoomSize ? position : RoomSize;
+		}
 
-			return RoomSize;
+		// Returns first filled position >= startPos, or RoomSize if there is no filled position
+		std::size_t _GetFilledPosition(const std::size_t startPos) const
+		{
+			// Bits past RoomSize are never set, so the result never exceeds RoomSize for a non-empty tail
+			std::size_t position = detail::FindNextSetBit(filledPositions, k_maskWordsCount, startPos);
+			return position < RoomSize ? position : RoomSize;
 		}
 
 	private:
-		T items[RoomSize];
-		std::bitset<RoomSize> filledPositions;
+		using ItemStorage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+		ItemStorage items[RoomSize]; // Raw items storage, only filled positions contain constructed objects
+		detail::BitWord filledPositions[k_maskWordsCount] = {};
 		int32_t roomIndex;
-		int8_t size = 0;
+		uint32_t size = 0U;
+		// All the positions below this one are known to be filled, so free slot search starts here
+		std::size_t firstFreePosition = 0U;
+	};
 
-		// [TODO] add cache of first and last free items cache for performance
+	// Rooms are allocated using pool allocation policy, so deleter keeps the policy to release room memory
+	struct RoomDeleter
+	{
+		AllocationPolicy policy;
+
+		void operator()(TRoom* room) const
+		{
+			room->~TRoom();
+			detail::FreeMemory(policy, room, sizeof(TRoom), alignof(TRoom));
+		}
 	};
 
-	using StorageType = std::list<TRoom>;
-	using StorageTypeIterator = typename std::list<TRoom>::iterator;
+	using RoomPtr = std::unique_ptr<TRoom, RoomDeleter>;
 	using ItemLocation = std::pair<std::size_t, std::size_t>;
 
 	struct InsertResult
@@ -129,36 +162,44 @@ public:
 	};
 
 public:
-	ObjectPool()
-		: m_firstIndex(GetInvalidPoolId())
+	ObjectPool() = default;
+
+	// Rooms are aligned to max(policy alignment, alignof(T)), policy also selects pages backing the rooms
+	explicit ObjectPool(const AllocationPolicy& policy)
+		: m_policy(policy)
+		, m_rooms(detail::GetMemoryResource(policy))
+		, m_availableRooms(detail::GetMemoryResource(policy))
+		, m_nonEmptyRooms(detail::GetMemoryResource(policy))
 	{}
 
 	~ObjectPool() = default;
 
-	ObjectPool(ObjectPool&& other)
-		: m_storage(std::move(other.m_storage))
-	{
-		FillPoolIteratorsInitial();
-	}
-
-	ObjectPool& operator=(ObjectPool&& other)
-	{
-		m_storage = std::move(other.m_storage);
-		FillPoolIteratorsInitial();
-
-		return *this;
-	}
+	// Rooms are owned by pointer, so moving the pool keeps items addresses valid
+	ObjectPool(ObjectPool&& other) = default;
+	ObjectPool& operator=(ObjectPool&& other) = default;
 
 	ObjectPool(const ObjectPool& other)
-		: m_storage(other.m_storage)
+		: m_policy(other.m_policy)
+		, m_itemsCount(other.m_itemsCount)
+		, m_rooms(detail::GetMemoryResource(other.m_policy))
+		, m_availableRooms(other.m_availableRooms, detail::GetMemoryResource(other.m_policy))
+		, m_nonEmptyRooms(other.m_nonEmptyRooms, detail::GetMemoryResource(other.m_policy))
+		, m_firstAvailableRoomWord(other.m_firstAvailableRoomWord)
 	{
-		FillPoolIteratorsInitial();
+		CopyRooms(other);
 	}
 
 	ObjectPool& operator=(const ObjectPool& other)
 	{
-		m_storage = other.m_storage;
-		FillPoolIteratorsInitial();
+		if (this != &other)
+		{
+			m_policy = other.m_policy;
+			m_itemsCount = other.m_itemsCount;
+			m_availableRooms = other.m_availableRooms;
+			m_nonEmptyRooms = other.m_nonEmptyRooms;
+			m_firstAvailableRoomWord = other.m_firstAvailableRoomWord;
+			CopyRooms(other);
+		}
 
 		return *this;
 	}
@@ -175,59 +216,128 @@ public:
 
 	T& At(const std::size_t index)
 	{
-		ItemLocation itemLocation = SplitIndexIntoRoomLocation(index);
-		return GetItemAtLocation(itemLocation);
+		return m_rooms[index / RoomSize]->GetMutable(index % RoomSize);
 	}
 
 	const T& At(const std::size_t index) const
 	{
-		ItemLocation itemLocation = SplitIndexIntoRoomLocation(index);
-		return GetItemAtLocation(itemLocation);
+		return m_rooms[index / RoomSize]->GetConst(index % RoomSize);
 	}
 
 	void RemoveAt(const std::size_t index)
 	{
 		ItemLocation itemLocation = SplitIndexIntoRoomLocation(index);
 
-		auto roomIt = m_poolIteratorById[itemLocation.first];
-		roomIt->Remove(itemLocation.second);
+		TRoom& room = *m_rooms[itemLocation.first];
+		room.Remove(itemLocation.second);
+
+		OnItemRemoved(room);
+	}
 
-		OnItemRemoved(roomIt);
+	// Creates rooms, so that count items can be inserted without creating new rooms
+	void Reserve(const std::size_t count)
+	{
+		const std::size_t requiredRoomsCount = (m_itemsCount + count + RoomSize - 1U) / RoomSize;
+		m_rooms.reserve(requiredRoomsCount);
+
+		while (m_rooms.size() < requiredRoomsCount)
+		{
+			CreateNewRoom();
+		}
+	}
+
+	/**
+	* @brief Releases memory of empty rooms. Items never move, so their indexes and addresses stay valid,
+	* released rooms in the middle of the pool are recreated on demand, trailing ones are removed from the directory.
+	* @return Count of released rooms
+	*/
+	std::size_t ReleaseEmptyRooms()
+	{
+		std::size_t releasedCount = 0U;
+		for (RoomPtr& room : m_rooms)
+		{
+			if (nullptr != room && 0U == room->size)
+			{
+				room.reset();
+				++releasedCount;
+			}
+		}
+
+		while (!m_rooms.empty() && nullptr == m_rooms.back())
+		{
+			detail::ResetBit(m_availableRooms.data(), m_rooms.size() - 1U);
+			m_rooms.pop_back();
+		}
+
+		const std::size_t wordsCount = detail::GetBitWordsCount(m_rooms.size());
+		m_availableRooms.resize(wordsCount);
+		m_nonEmptyRooms.resize(wordsCount);
+		m_rooms.shrink_to_fit();
+		m_availableRooms.shrink_to_fit();
+		m_nonEmptyRooms.shrink_to_fit();
+
+		return releasedCount;
 	}
 
 	void Clear()
 	{
-		m_storage.clear();
-		m_poolIteratorById.clear();
+		m_itemsCount = 0U;
+		m_rooms.clear();
 		m_availableRooms.clear();
+		m_nonEmptyRooms.clear();
+		m_firstAvailableRoomWord = 0U;
 	}
 
 	InsertResult Push(const T& object)
 	{
-		StorageTypeIterator roomIt = GetRoomForInsertion();
-		std::size_t roomDataIndex = roomIt->Push(object);
-		OnItemInserted(roomIt);
+		TRoom& room = GetRoomForInsertion();
+		std::size_t roomDataIndex = room.Push(object);
+		OnItemInserted(room);
 
-		return GenInsertResult(roomIt, roomDataIndex);
+		return GenInsertResult(room, roomDataIndex);
 	}
 
 	InsertResult Push(T&& object)
 	{
-		StorageTypeIterator roomIt = GetRoomForInsertion();
-		std::size_t roomDataIndex = roomIt->Push(std::move(object));
-		OnItemInserted(roomIt);
+		TRoom& room = GetRoomForInsertion();
+		std::size_t roomDataIndex = room.Push(std::move(object));
+		OnItemInserted(room);
 
-		return GenInsertResult(roomIt, roomDataIndex);
+		return GenInsertResult(room, roomDataIndex);
 	}
 
 	template <typename ...Args>
 	InsertResult Emplace(Args&&... args)
 	{
-		StorageTypeIterator roomIt = GetRoomForInsertion();
-		std::size_t roomDataIndex = roomIt->Emplace(std::forward<Args>(args)...);
-		OnItemInserted(roomIt);
+		TRoom& room = GetRoomForInsertion();
+		std::size_t roomDataIndex = room.Emplace(std::forward<Args>(args)...);
+		OnItemInserted(room);
+
+		return GenInsertResult(room, roomDataIndex);
+	}
+
+	/**
+	* @brief Constructs count items from the same arguments, filling each room before moving to the next one
+	* @param visitor - invoked with InsertResult of every inserted item
+	*/
+	template <typename Visitor, typename ...Args>
+	void EmplaceMany(std::size_t count, Visitor&& visitor, const Args&... args)
+	{
+		while (count > 0U)
+		{
+			TRoom& room = GetRoomForInsertion();
+			for (; count > 0U && room.size < RoomSize; --count)
+			{
+				const std::size_t roomDataIndex = room.Emplace(args...);
+				OnItemInserted(room);
+				visitor(GenInsertResult(room, roomDataIndex));
+			}
+		}
+	}
 
-		return GenInsertResult(roomIt, roomDataIndex);
+	std::size_t GetItemsCount() const
+	{
+		return m_itemsCount;
 	}
 	
 public:
@@ -280,7 +390,7 @@ public:
 
 	iterator begin()
 	{
-		return iterator(this, m_firstIndex);
+		return iterator(this, GetNextObjectIndex(0U));
 	}
 
 	iterator end()
@@ -288,19 +398,27 @@ public:
 		return iterator(this, GetInvalidPoolId());
 	}
 
+	// Returns index of the first alive object with index >= provided one, or invalid pool id if there is no such object
 	std::size_t GetNextObjectIndex(const std::size_t index) const
 	{
-		std::size_t startRoomPos = index % RoomSize;
-		for (std::size_t poolId = index / RoomSize; poolId < m_poolIteratorById.size(); ++poolId)
+		const std::size_t roomsCount = m_rooms.size();
+		std::size_t roomId = index / RoomSize;
+		if (roomId >= roomsCount)
+			return GetInvalidPoolId();
+
+		// Try to find object in the tail of the current room (released rooms are empty)
+		std::size_t filledPos = (nullptr != m_rooms[roomId]) ? m_rooms[roomId]->_GetFilledPosition(index % RoomSize) : RoomSize;
+		if (filledPos != RoomSize)
 		{
-			std::size_t filledPos = m_poolIteratorById[poolId]->_GetFilledPosition(startRoomPos);
-			if (filledPos != RoomSize)
-			{
-				return poolId * RoomSize + filledPos;
-			}
+			return roomId * RoomSize + filledPos;
 		}
 
-		return GetInvalidPoolId();
+		// Skip empty rooms using summary bitmap, first filled position of non empty room always exists
+		roomId = detail::FindNextSetBit(m_nonEmptyRooms.data(), m_nonEmptyRooms.size(), roomId + 1U);
+		if (roomId >= roomsCount)
+			return GetInvalidPoolId();
+
+		return roomId * RoomSize + m_rooms[roomId]->_GetFilledPosition(0U);
 	}
 
 	const std::size_t GetInvalidPoolId() const
@@ -311,100 +429,105 @@ public:
 private:
 	friend struct iterator;
 
-	StorageTypeIterator GetRoomForInsertion()
+	TRoom& GetRoomForInsertion()
 	{
-		if (m_availableRooms.empty())
+		// Lowest room with free space is preferred to keep items packed at the beginning of the pool
+		const std::size_t roomId = detail::FindNextSetBit(m_availableRooms.data(), m_availableRooms.size(), m_firstAvailableRoomWord * detail::k_bitWordSize);
+		if (roomId < m_rooms.size() && nullptr == m_rooms[roomId])
 		{
-			return CreateNewRoom();
-		}
-		else
-		{
-			return *m_availableRooms.begin();
+			// Room has been released while empty, so it is recreated in place
+			m_rooms[roomId] = AllocateRoom(static_cast<int32_t>(roomId));
 		}
+
+		TRoom& room = (roomId < m_rooms.size()) ? *m_rooms[roomId] : CreateNewRoom();
+
+		m_firstAvailableRoomWord = room.roomIndex / detail::k_bitWordSize;
+		return room;
 	}
 
-	StorageTypeIterator CreateNewRoom()
+	TRoom& CreateNewRoom()
 	{
-		int32_t roomId = static_cast<int32_t>(m_storage.size());
-		m_storage.emplace_back(roomId);
-		StorageTypeIterator insertedIt = std::prev(m_storage.end());
+		int32_t roomId = static_cast<int32_t>(m_rooms.size());
+		m_rooms.push_back(AllocateRoom(roomId));
+
+		const std::size_t requiredWordsCount = detail::GetBitWordsCount(m_rooms.size());
+		if (m_availableRooms.size() < requiredWordsCount)
+		{
+			m_availableRooms.push_back(0U);
+			m_nonEmptyRooms.push_back(0U);
+		}
 
-		m_poolIteratorById.push_back(insertedIt);
-		m_availableRooms.insert(insertedIt);
+		detail::SetBit(m_availableRooms.data(), roomId);
 
-		return insertedIt;
+		return *m_rooms.back();
 	}
 
-	void OnItemInserted(StorageTypeIterator roomIt)
+	void OnItemInserted(TRoom& room)
 	{
-		auto it = m_availableRooms.find(roomIt);
-		assert(it != m_availableRooms.end());
+		++m_itemsCount;
+		detail::SetBit(m_nonEmptyRooms.data(), room.roomIndex);
 
-		if (it != m_availableRooms.end())
+		if (room.size >= RoomSize)
 		{
-			if (roomIt->size >= RoomSize)
-			{
-				m_availableRooms.erase(it);
-			}
+			detail::ResetBit(m_availableRooms.data(), room.roomIndex);
 		}
 	}
 
-	void OnItemRemoved(StorageTypeIterator roomIt)
+	void OnItemRemoved(TRoom& room)
 	{
-		// Room became not full, so add it to available rooms
-		m_availableRooms.insert(roomIt);
-	}
+		--m_itemsCount;
 
-	void FillPoolIteratorsInitial()
-	{
-		m_poolIteratorById.reserve(m_storage.size());
+		// Room became not full, so add it to available rooms
+		detail::SetBit(m_availableRooms.data(), room.roomIndex);
 
-		for (auto it = m_storage.begin(); it != m_storage.end(); ++it)
+		const std::size_t roomWord = room.roomIndex / detail::k_bitWordSize;
+		if (roomWord < m_firstAvailableRoomWord)
 		{
-			m_poolIteratorById.push_back(it);
+			m_firstAvailableRoomWord = roomWord;
+		}
 
-			if (it->size() < RoomSize)
-			{
-				m_availableRooms.push_back(it);
-			}
+		if (room.size == 0U)
+		{
+			detail::ResetBit(m_nonEmptyRooms.data(), room.roomIndex);
 		}
 	}
 
-	ItemLocation SplitIndexIntoRoomLocation(const std::size_t index) const
+	void CopyRooms(const ObjectPool& other)
 	{
-		return ItemLocation(index / RoomSize, index % RoomSize);
+		m_rooms.clear();
+		m_rooms.reserve(other.m_rooms.size());
+
+		for (const RoomPtr& room : other.m_rooms)
+		{
+			m_rooms.push_back((nullptr != room) ? AllocateRoom(*room) : RoomPtr(nullptr, RoomDeleter{ m_policy }));
+		}
 	}
 
-	const T& GetItemAtLocation(const ItemLocation& location) const
+	// Constructs room in memory allocated with pool policy, from room constructor arguments
+	template <typename ...Args>
+	RoomPtr AllocateRoom(Args&&... args) const
 	{
-		auto roomIt = m_poolIteratorById[location.first];
-		return roomIt->GetConst(location.second);
+		void* memory = detail::AllocateMemory(m_policy, sizeof(TRoom), alignof(TRoom));
+		return RoomPtr(new (memory) TRoom(std::forward<Args>(args)...), RoomDeleter{ m_policy });
 	}
 
-	T& GetItemAtLocation(const ItemLocation& location)
+	ItemLocation SplitIndexIntoRoomLocation(const std::size_t index) const
 	{
-		auto roomIt = m_poolIteratorById[location.first];
-		return roomIt->GetMutable(location.second);
+		return ItemLocation(index / RoomSize, index % RoomSize);
 	}
 
-	InsertResult GenInsertResult(StorageTypeIterator roomIt, const std::size_t dataIndex) const
+	InsertResult GenInsertResult(TRoom& room, const std::size_t dataIndex) const
 	{
-		return InsertResult(roomIt->items[dataIndex], roomIt->roomIndex * RoomSize + dataIndex);
+		return InsertResult(room.GetMutable(dataIndex), room.roomIndex * RoomSize + dataIndex);
 	}
 
 private:
-	struct StorageTypeIteratorHasher
-	{
-		std::size_t operator()(StorageTypeIterator it) const
-		{
-			return std::hash<int>()(it->roomIndex);
-		}
-	};
-
-	StorageType m_storage;
-	std::vector<StorageTypeIterator> m_poolIteratorById;
-	std::unordered_set<StorageTypeIterator, StorageTypeIteratorHasher> m_availableRooms;
-	std::size_t m_firstIndex;
+	AllocationPolicy m_policy;
+	std::size_t m_itemsCount = 0U;
+	std::pmr::vector<RoomPtr> m_rooms; // Rooms directory, room addresses never change while room is alive
+	std::pmr::vector<detail::BitWord> m_availableRooms; // Bitmap with a bit per room, which is set when room has free space
+	std::pmr::vector<detail::BitWord> m_nonEmptyRooms; // Summary bitmap with a bit per room, which is set when room is not empty
+	std::size_t m_firstAvailableRoomWord = 0U; // All the available rooms bitmap words below this one are known to be empty
 };
 
 }
@@ -0,0 +1,310 @@
+#pragma once
+#include "ecs/detail/Relocate.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+namespace ecs
+{
+
+/**
+* @brief Vector, which keeps first InlineCapacity items inside the object, and moves them to memory resource allocation,
+* when it grows beyond that. Small vectors don't allocate at all, and their items share cache lines with the owner.
+* Items are moved between buffers by relocation (see IsTriviallyRelocatable), so trivially relocatable items
+* are moved with memcpy.
+*/
+template <typename T, std::size_t InlineCapacity>
+class SmallVector
+{
+	static_assert(InlineCapacity > 0U, "Small vector must have inline capacity");
+
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	explicit SmallVector(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+		: m_resource(resource)
+	{}
+
+	SmallVector(SmallVector&& other) noexcept
+		: m_resource(other.m_resource)
+	{
+		MoveFrom(other);
+	}
+
+	SmallVector& operator=(SmallVector&& other) noexcept
+	{
+		if (this != &other)
+		{
+			clear();
+			MoveFrom(other);
+		}
+
+		return *this;
+	}
+
+	SmallVector(const SmallVector&) = delete;
+	SmallVector& operator=(const SmallVector&) = delete;
+
+	~SmallVector()
+	{
+		clear();
+		FreeHeapBuffer();
+	}
+
+	std::size_t size() const
+	{
+		return m_size;
+	}
+
+	bool empty() const
+	{
+		return m_size == 0U;
+	}
+
+	std::size_t capacity() const
+	{
+		return m_capacity;
+	}
+
+	// Returns true if items are kept inside the object
+	bool IsInline() const
+	{
+		return m_data == GetInlineBuffer();
+	}
+
+	T* data()
+	{
+		return m_data;
+	}
+
+	const T* data() const
+	{
+		return m_data;
+	}
+
+	iterator begin()
+	{
+		return m_data;
+	}
+
+	iterator end()
+	{
+		return m_data + m_size;
+	}
+
+	const_iterator begin() const
+	{
+		return m_data;
+	}
+
+	const_iterator end() const
+	{
+		return m_data + m_size;
+	}
+
+	T& operator[](const std::size_t index)
+	{
+		assert(index < m_size);
+		return m_data[index];
+	}
+
+	const T& operator[](const std::size_t index) const
+	{
+		assert(index < m_size);
+		return m_data[index];
+	}
+
+	T& back()
+	{
+		assert(m_size > 0U);
+		return m_data[m_size - 1U];
+	}
+
+	template <typename ...Args>
+	T& emplace_back(Args&&... args)
+	{
+		if (m_size == m_capacity)
+		{
+			Grow(m_size + 1U);
+		}
+
+		T* item = new (m_data + m_size) T(std::forward<Args>(args)...);
+		++m_size;
+
+		return *item;
+	}
+
+	void push_back(const T& value)
+	{
+		emplace_back(value);
+	}
+
+	void push_back(T&& value)
+	{
+		emplace_back(std::move(value));
+	}
+
+	// Inserts item before position, shifting the following items
+	iterator insert(const_iterator position, const T& value)
+	{
+		const std::size_t index = static_cast<std::size_t>(position - m_data);
+		assert(index <= m_size);
+
+		if (m_size == m_capacity)
+		{
+			Grow(m_size + 1U);
+		}
+
+		// Shift tail by one item, starting from the last item, so overlapping items are relocated before being overwritten
+		for (std::size_t i = m_size; i > index; --i)
+		{
+			detail::RelocateAt(m_data + i, m_data + i - 1U);
+		}
+
+		new (m_data + index) T(value);
+		++m_size;
+
+		return m_data + index;
+	}
+
+	// Erases item at position, shifting the following items
+	iterator erase(const_iterator position)
+	{
+		const std::size_t index = static_cast<std::size_t>(position - m_data);
+		assert(index < m_size);
+
+		detail::DestroyAt(m_data + index);
+		detail::RelocateRange(m_data + index, m_data + index + 1U, m_size - index - 1U);
+		--m_size;
+
+		return m_data + index;
+	}
+
+	void pop_back()
+	{
+		assert(m_size > 0U);
+		--m_size;
+		detail::DestroyAt(m_data + m_size);
+	}
+
+	void clear()
+	{
+		detail::DestroyRange(m_data, m_size);
+		m_size = 0U;
+	}
+
+	void reserve(const std::size_t capacity)
+	{
+		if (capacity > m_capacity)
+		{
+			Grow(capacity);
+		}
+	}
+
+	// Moves items back inside the object, when they fit, or trims heap buffer to the items count
+	void shrink_to_fit()
+	{
+		if (IsInline() || m_size == m_capacity)
+			return;
+
+		T* heapBuffer = m_data;
+		const std::size_t heapCapacity = m_capacity;
+
+		if (m_size <= InlineCapacity)
+		{
+			m_data = GetInlineBuffer();
+			m_capacity = InlineCapacity;
+		}
+		else
+		{
+			m_data = static_cast<T*>(m_resource->allocate(m_size * sizeof(T), alignof(T)));
+			m_capacity = m_size;
+		}
+
+		detail::RelocateRange(m_data, heapBuffer, m_size);
+		m_resource->deallocate(heapBuffer, heapCapacity * sizeof(T), alignof(T));
+	}
+
+	std::pmr::memory_resource* GetMemoryResource() const
+	{
+		return m_resource;
+	}
+
+private:
+	T* GetInlineBuffer()
+	{
+		return reinterpret_cast<T*>(m_inlineBuffer);
+	}
+
+	const T* GetInlineBuffer() const
+	{
+		return reinterpret_cast<const T*>(m_inlineBuffer);
+	}
+
+	void Grow(const std::size_t minCapacity)
+	{
+		std::size_t newCapacity = m_capacity * 2U;
+		if (newCapacity < minCapacity)
+		{
+			newCapacity = minCapacity;
+		}
+
+		T* newData = static_cast<T*>(m_resource->allocate(newCapacity * sizeof(T), alignof(T)));
+		detail::RelocateRange(newData, m_data, m_size);
+
+		FreeHeapBuffer();
+		m_data = newData;
+		m_capacity = newCapacity;
+	}
+
+	void FreeHeapBuffer()
+	{
+		if (!IsInline())
+		{
+			m_resource->deallocate(m_data, m_capacity * sizeof(T), alignof(T));
+			m_data = GetInlineBuffer();
+			m_capacity = InlineCapacity;
+		}
+	}
+
+	// Takes items of other vector, which is left empty. This vector must be empty.
+	void MoveFrom(SmallVector& other)
+	{
+		assert(m_size == 0U);
+
+		if (!other.IsInline() && *m_resource == *other.m_resource)
+		{
+			// Heap buffer is taken over
+			FreeHeapBuffer();
+			m_data = other.m_data;
+			m_capacity = other.m_capacity;
+			m_size = other.m_size;
+
+			other.m_data = other.GetInlineBuffer();
+			other.m_capacity = InlineCapacity;
+			other.m_size = 0U;
+			return;
+		}
+
+		reserve(other.m_size);
+		detail::RelocateRange(m_data, other.m_data, other.m_size);
+		m_size = other.m_size;
+		other.m_size = 0U;
+	}
+
+private:
+	T* m_data = GetInlineBuffer();
+	uint32_t m_size = 0U;
+	uint32_t m_capacity = InlineCapacity;
+	std::pmr::memory_resource* m_resource;
+	alignas(T) unsigned char m_inlineBuffer[InlineCapacity * sizeof(T)];
+};
+
+} // namespace ecs
@@ -0,0 +1,116 @@
+#pragma once
+#include "ecs/TypeAliases.hpp"
+#include "ecs/detail/EntityIdBits.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <memory_resource>
+#include <vector>
+
+namespace ecs
+{
+
+/**
+* @brief Paged sparse table, mapping entity ids to dense storage indexes.
+*
+* Lookup costs two loads (page pointer and page entry). Pages are allocated lazily,
+* so memory is spent only for the id ranges, that have been mapped at least once.
+* Table is indexed by entity storage index (generation bits are ignored), so it maps alive entities only,
+* and entries must be erased, when entity leaves the storage.
+*/
+class SparseIndex
+{
+	static constexpr std::size_t k_pageSizeBits = 12U;
+	static constexpr std::size_t k_pageSize = std::size_t(1) << k_pageSizeBits;
+
+public:
+	using IndexType = int32_t;
+
+	SparseIndex() = default;
+
+	// Pages are allocated from provided memory resource
+	explicit SparseIndex(std::pmr::memory_resource* resource)
+		: m_pages(resource)
+	{}
+
+	static constexpr IndexType GetInvalidIndex()
+	{
+		return IndexType(-1);
+	}
+
+	IndexType Find(const EntityId entityId) const
+	{
+		const std::size_t entityIndex = detail::GetEntityIndex(entityId);
+		const std::size_t pageIndex = entityIndex >> k_pageSizeBits;
+		if (pageIndex < m_pages.size() && !m_pages[pageIndex].empty())
+		{
+			return m_pages[pageIndex][entityIndex & (k_pageSize - 1U)];
+		}
+
+		return GetInvalidIndex();
+	}
+
+	void Set(const EntityId entityId, const IndexType index)
+	{
+		assert(entityId >= 0);
+		const std::size_t entityIndex = detail::GetEntityIndex(entityId);
+		GetPage(entityIndex >> k_pageSizeBits)[entityIndex & (k_pageSize - 1U)] = index;
+	}
+
+	void Erase(const EntityId entityId)
+	{
+		const std::size_t entityIndex = detail::GetEntityIndex(entityId);
+		const std::size_t pageIndex = entityIndex >> k_pageSizeBits;
+		if (pageIndex < m_pages.size() && !m_pages[pageIndex].empty())
+		{
+			m_pages[pageIndex][entityIndex & (k_pageSize - 1U)] = GetInvalidIndex();
+		}
+	}
+
+	// Frees pages, which don't map any entity
+	void ReleaseEmptyPages()
+	{
+		for (std::pmr::vector<IndexType>& page : m_pages)
+		{
+			const bool isPageEmpty = std::all_of(page.begin(), page.end(), [](const IndexType index) { return GetInvalidIndex() == index; });
+			if (isPageEmpty)
+			{
+				page.clear();
+				page.shrink_to_fit();
+			}
+		}
+
+		while (!m_pages.empty() && m_pages.back().empty())
+		{
+			m_pages.pop_back();
+		}
+	}
+
+	void Clear()
+	{
+		m_pages.clear();
+	}
+
+private:
+	IndexType* GetPage(const std::size_t pageIndex)
+	{
+		if (pageIndex >= m_pages.size())
+		{
+			m_pages.resize(pageIndex + 1U);
+		}
+
+		// Page vectors are constructed with pages table memory resource
+		std::pmr::vector<IndexType>& page = m_pages[pageIndex];
+		if (page.empty())
+		{
+			page.assign(k_pageSize, GetInvalidIndex());
+		}
+
+		return page.data();
+	}
+
+private:
+	std::pmr::vector<std::pmr::vector<IndexType>> m_pages; // Empty vector for pages, which haven't been allocated yet
+};
+
+} // namespace ecs
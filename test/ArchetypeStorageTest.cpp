@@ -0,0 +1,159 @@
+#include <ecs/Manager.hpp>
+#include <gtest/gtest.h>
+
+#include <string>
+
+namespace test
+{
+
+struct ArchetypePosition
+{
+	float x;
+	float y;
+};
+
+struct ArchetypeVelocity
+{
+	float x;
+	float y;
+};
+
+struct ArchetypeName
+{
+	std::string value;
+};
+
+} // namespace test
+
+ECS_COMPONENT_STORAGE(test::ArchetypePosition, ecs::ArchetypeComponentCollection)
+ECS_COMPONENT_STORAGE(test::ArchetypeVelocity, ecs::ArchetypeComponentCollection)
+ECS_COMPONENT_STORAGE(test::ArchetypeName, ecs::ArchetypeComponentCollection)
+
+namespace test
+{
+
+class ArchetypeStorageTest
+	: public ::testing::Test
+{
+protected:
+	ArchetypeStorageTest()
+	{
+		ecs::Manager::InitECSManager();
+		manager = ecs::Manager::Get();
+
+		manager->RegisterComponentType<ArchetypePosition>("ArchetypePosition");
+		manager->RegisterComponentType<ArchetypeVelocity>("ArchetypeVelocity");
+		manager->RegisterComponentType<ArchetypeName>("ArchetypeName");
+		manager->Init();
+	}
+
+	~ArchetypeStorageTest() override
+	{
+		ecs::Manager::ShutdownECSManager();
+	}
+
+	ecs::Entity CreateMovingEntity(const float position, const float velocity)
+	{
+		ecs::Entity entity = manager->CreateEntity();
+		entity.AddComponent(manager->CreateComponent<ArchetypePosition>(position, 0.f));
+		entity.AddComponent(manager->CreateComponent<ArchetypeVelocity>(velocity, 0.f));
+
+		return entity;
+	}
+
+	ecs::Manager* manager = nullptr;
+};
+
+// Components of the same entity must be placed into the same archetype row
+TEST_F(ArchetypeStorageTest, AttachMovesEntityBetweenArchetypesTest)
+{
+	ecs::Entity entity = CreateMovingEntity(1.f, 2.f);
+
+	ecs::Archetype* archetype = manager->GetArchetypeStorage().GetEntityArchetype(entity.GetId());
+	ASSERT_NE(archetype, nullptr);
+	EXPECT_EQ(archetype->GetTypeIds().size(), 2U);
+	EXPECT_EQ(archetype->GetSize(), 1U);
+	EXPECT_EQ(archetype->GetEntity(0U), entity.GetId());
+
+	// Handles created before the move must point to the moved data
+	EXPECT_EQ(entity.GetComponent<ArchetypePosition>()->x, 1.f);
+	EXPECT_EQ(entity.GetComponent<ArchetypeVelocity>()->x, 2.f);
+	EXPECT_EQ(entity.GetComponent<ArchetypePosition>().Get(), archetype->GetComponentData(archetype->GetColumnIndex(manager->GetComponentTypeId<ArchetypePosition>()), 0U));
+}
+
+TEST_F(ArchetypeStorageTest, DetachKeepsComponentAliveTest)
+{
+	ecs::Entity entity = CreateMovingEntity(1.f, 2.f);
+	ecs::Entity other = CreateMovingEntity(3.f, 4.f);
+	ecs::Archetype* movingArchetype = manager->GetArchetypeStorage().GetEntityArchetype(entity.GetId());
+
+	ecs::ComponentPtr velocity = entity.GetComponent<ArchetypeVelocity>();
+	entity.RemoveComponent(velocity);
+
+	// Removed row is filled with the last one
+	EXPECT_EQ(movingArchetype->GetSize(), 1U);
+	EXPECT_EQ(other.GetComponent<ArchetypePosition>()->x, 3.f);
+	EXPECT_EQ(other.GetComponent<ArchetypeVelocity>()->x, 4.f);
+
+	EXPECT_EQ(manager->GetArchetypeStorage().GetEntityArchetype(entity.GetId())->GetTypeIds().size(), 1U);
+	EXPECT_EQ(entity.GetComponent<ArchetypePosition>()->x, 1.f);
+	EXPECT_EQ(ecs::Cast<ArchetypeVelocity>(velocity)->x, 2.f);
+
+	// Attaching back must reuse cached transition
+	entity.AddComponent(velocity);
+	EXPECT_EQ(manager->GetArchetypeStorage().GetEntityArchetype(entity.GetId()), movingArchetype);
+	EXPECT_EQ(entity.GetComponent<ArchetypeVelocity>()->x, 2.f);
+}
+
+TEST_F(ArchetypeStorageTest, ChunkIterationTest)
+{
+	const int k_entitiesCount = 2000;
+	std::vector<ecs::Entity> entities;
+	for (int i = 0; i < k_entitiesCount; ++i)
+	{
+		entities.push_back(CreateMovingEntity(static_cast<float>(i), 1.f));
+	}
+
+	// Entities with an additional component live in another archetype, but must be matched too
+	entities[0].AddComponent(manager->CreateComponent<ArchetypeName>("first"));
+
+	std::size_t chunksCount = 0U;
+	std::size_t rowsCount = 0U;
+	manager->ForEachArchetypeChunk<ArchetypePosition, ArchetypeVelocity>([&](std::size_t count, const ecs::EntityId*, ArchetypePosition* positions, ArchetypeVelocity* velocities)
+	{
+		for (std::size_t i = 0U; i < count; ++i)
+		{
+			positions[i].x += velocities[i].x;
+		}
+
+		++chunksCount;
+		rowsCount += count;
+	});
+
+	EXPECT_EQ(rowsCount, static_cast<std::size_t>(k_entitiesCount));
+	EXPECT_GT(chunksCount, 2U);
+	EXPECT_EQ(entities[0].GetComponent<ArchetypePosition>()->x, 1.f);
+	EXPECT_EQ(entities[k_entitiesCount - 1].GetComponent<ArchetypePosition>()->x, static_cast<float>(k_entitiesCount));
+	EXPECT_EQ(entities[0].GetComponent<ArchetypeName>()->value, "first");
+}
+
+TEST_F(ArchetypeStorageTest, EntityDestructionReleasesRowTest)
+{
+	ecs::EntityId entityId = ecs::Entity::GetInvalidId();
+	{
+		ecs::Entity entity = CreateMovingEntity(1.f, 2.f);
+		entity.AddComponent(manager->CreateComponent<ArchetypeName>(std::string(100, 'a')));
+		entityId = entity.GetId();
+	}
+
+	EXPECT_EQ(manager->GetArchetypeStorage().GetEntityArchetype(entityId), nullptr);
+
+	std::size_t rowsCount = 0U;
+	manager->ForEachArchetypeChunk<ArchetypePosition>([&](std::size_t count, const ecs::EntityId*, ArchetypePosition*)
+	{
+		rowsCount += count;
+	});
+	EXPECT_EQ(rowsCount, 0U);
+}
+
+} // namespace test
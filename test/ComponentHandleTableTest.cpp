@@ -0,0 +1,93 @@
+#include <ecs/storage/ComponentHandleTable.hpp>
+#include <gtest/gtest.h>
+
+#include <limits>
+
+namespace test
+{
+
+// Registered blocks must resolve by slot and generation, until they are unregistered
+TEST(ComponentHandleTableTest, ResolveTest)
+{
+	ecs::ComponentHandleTable table;
+	ecs::ComponentPtrBlock blocks[2];
+
+	table.Register(blocks[0]);
+	table.Register(blocks[1]);
+
+	EXPECT_EQ(table.Resolve(blocks[1].handleIndex, blocks[1].handleGeneration), &blocks[1]);
+	EXPECT_EQ(table.Resolve(100U, 0U), nullptr);
+
+	table.Unregister(blocks[0]);
+	EXPECT_EQ(table.Resolve(blocks[0].handleIndex, blocks[0].handleGeneration), nullptr);
+}
+
+// Reused slot must get new generation, so stale handles don't resolve to the new block
+TEST(ComponentHandleTableTest, SlotReuseTest)
+{
+	ecs::ComponentHandleTable table;
+	ecs::ComponentPtrBlock oldBlock;
+	ecs::ComponentPtrBlock newBlock;
+
+	table.Register(oldBlock);
+	const uint32_t staleIndex = oldBlock.handleIndex;
+	const uint16_t staleGeneration = oldBlock.handleGeneration;
+	table.Unregister(oldBlock);
+	table.Register(newBlock);
+
+	EXPECT_EQ(newBlock.handleIndex, staleIndex);
+	EXPECT_NE(newBlock.handleGeneration, staleGeneration);
+	EXPECT_EQ(table.Resolve(staleIndex, staleGeneration), nullptr);
+	EXPECT_EQ(table.Resolve(newBlock.handleIndex, newBlock.handleGeneration), &newBlock);
+
+	table.UnregisterAll();
+	EXPECT_EQ(table.Resolve(newBlock.handleIndex, newBlock.handleGeneration), nullptr);
+}
+
+// Freed slots must be reused in the order they were freed
+TEST(ComponentHandleTableTest, FifoReuseTest)
+{
+	ecs::ComponentHandleTable table;
+	ecs::ComponentPtrBlock blocks[3];
+	for (ecs::ComponentPtrBlock& block : blocks)
+	{
+		table.Register(block);
+	}
+
+	const uint32_t firstFreed = blocks[2].handleIndex;
+	const uint32_t secondFreed = blocks[0].handleIndex;
+	table.Unregister(blocks[2]);
+	table.Unregister(blocks[0]);
+
+	ecs::ComponentPtrBlock newBlocks[2];
+	table.Register(newBlocks[0]);
+	table.Register(newBlocks[1]);
+	EXPECT_EQ(newBlocks[0].handleIndex, firstFreed);
+	EXPECT_EQ(newBlocks[1].handleIndex, secondFreed);
+}
+
+// Slot churned through all the generations must be retired, so the first handle never resolves to a newer block
+TEST(ComponentHandleTableTest, GenerationChurnTest)
+{
+	ecs::ComponentHandleTable table;
+	ecs::ComponentPtrBlock block;
+
+	table.Register(block);
+	const uint32_t staleIndex = block.handleIndex;
+	const uint16_t staleGeneration = block.handleGeneration;
+	table.Unregister(block);
+
+	for (uint32_t i = 0U; i < 70000U; ++i)
+	{
+		table.Register(block);
+		ASSERT_EQ(table.Resolve(staleIndex, staleGeneration), nullptr);
+		table.Unregister(block);
+	}
+
+	// Retired slot isn't reused, new blocks get new slots
+	EXPECT_NE(block.handleIndex, staleIndex);
+	EXPECT_EQ(table.Resolve(staleIndex, staleGeneration), nullptr);
+	EXPECT_EQ(table.Resolve(staleIndex, std::numeric_limits<uint16_t>::max()), nullptr);
+}
+
+} // namespace
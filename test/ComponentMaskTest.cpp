@@ -0,0 +1,97 @@
+#include <ecs/detail/ComponentMask.hpp>
+#include <gtest/gtest.h>
+#include <unordered_set>
+#include <vector>
+
+namespace test
+{
+
+using WideMask = ecs::detail::ComponentMask<1024U>;
+using NarrowMask = ecs::detail::ComponentMask<64U>;
+
+// Containment must hold for subsets and fail on any missing bit, including bits in the last words
+TEST(ComponentMaskTest, ContainsTest)
+{
+	WideMask entity;
+	WideMask query;
+	entity.set(3U).set(200U).set(1023U);
+
+	EXPECT_TRUE(entity.Contains(query));
+
+	query.set(200U).set(1023U);
+	EXPECT_TRUE(entity.Contains(query));
+	EXPECT_FALSE(query.Contains(entity));
+
+	query.set(700U);
+	EXPECT_FALSE(entity.Contains(query));
+
+	NarrowMask narrow;
+	NarrowMask narrowQuery;
+	narrow.set(1U);
+	narrowQuery.set(1U);
+	EXPECT_TRUE(narrow.Contains(narrowQuery));
+	narrowQuery.set(63U);
+	EXPECT_FALSE(narrow.Contains(narrowQuery));
+}
+
+// Bitset like operations must match std::bitset semantics
+TEST(ComponentMaskTest, BitsTest)
+{
+	WideMask mask;
+	EXPECT_TRUE(mask.none());
+	EXPECT_EQ(mask.size(), 1024U);
+
+	mask.set(5U).set(64U).set(900U, true).set(5U, false);
+	EXPECT_FALSE(mask.test(5U));
+	EXPECT_TRUE(mask.test(900U));
+	EXPECT_EQ(mask.count(), 2U);
+	EXPECT_EQ(mask.FindNext(0U), 64U);
+	EXPECT_EQ(mask.FindNext(65U), 900U);
+	EXPECT_EQ(mask.FindNext(901U), mask.size());
+
+	std::vector<std::size_t> bits;
+	mask.ForEachSetBit([&bits](const std::size_t bit) { bits.push_back(bit); });
+	EXPECT_EQ(bits, (std::vector<std::size_t>{ 64U, 900U }));
+
+	WideMask other;
+	other.set(900U);
+	EXPECT_EQ((mask & other), other);
+	EXPECT_NE(mask, other);
+
+	mask.reset();
+	EXPECT_FALSE(mask.any());
+}
+
+// Rank of the bit must count only lower bits, which aren't excluded, across word boundaries
+TEST(ComponentMaskTest, CountBelowTest)
+{
+	WideMask mask;
+	WideMask excluded;
+	mask.set(0U).set(10U).set(63U).set(64U).set(300U);
+	excluded.set(10U);
+
+	EXPECT_EQ(mask.CountBelow(0U, excluded), 0U);
+	EXPECT_EQ(mask.CountBelow(10U, excluded), 1U);
+	EXPECT_EQ(mask.CountBelow(64U, excluded), 2U);
+	EXPECT_EQ(mask.CountBelow(65U, excluded), 3U);
+	EXPECT_EQ(mask.CountBelow(300U, excluded), 3U);
+	EXPECT_EQ(mask.CountBelow(1023U, WideMask()), 5U);
+}
+
+// Equal masks must have equal hashes, so masks can key hash maps
+TEST(ComponentMaskTest, HashTest)
+{
+	std::unordered_set<WideMask> masks;
+	WideMask first;
+	WideMask second;
+	first.set(10U);
+	second.set(10U);
+
+	masks.insert(first);
+	EXPECT_EQ(masks.count(second), 1U);
+
+	second.set(500U);
+	EXPECT_EQ(masks.count(second), 0U);
+}
+
+} // namespace
@@ -0,0 +1,110 @@
+#include <ecs/component/DenseComponentCollection.hpp>
+#include <gtest/gtest.h>
+
+namespace test
+{
+
+struct DenseTestComponent
+{
+	int value;
+};
+
+const ecs::ComponentTypeId k_testTypeId = 0;
+
+class DenseComponentCollectionTest
+	: public ::testing::Test
+{
+protected:
+	using CollectionType = ecs::DenseComponentCollection<DenseTestComponent>;
+
+	// Creates components with values [0, count) and attaches them to entities with the same ids
+	void FillCollection(CollectionType& collection, const int count)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			ecs::ComponentPtr handle = collection.Emplace(i);
+			collection.OnComponentEntityChanged(static_cast<std::size_t>(i), static_cast<ecs::EntityId>(i));
+		}
+	}
+};
+
+TEST_F(DenseComponentCollectionTest, EntityLookupTest)
+{
+	CollectionType collection(k_testTypeId);
+	FillCollection(collection, 10);
+
+	ASSERT_NE(collection.GetByEntity(7), nullptr);
+	EXPECT_EQ(collection.GetByEntity(7)->value, 7);
+	EXPECT_EQ(collection.GetByEntity(10), nullptr);
+	EXPECT_EQ(collection.GetByEntity(100000), nullptr);
+}
+
+// Removed slot must be filled with the last component, keeping array dense and mappings valid
+TEST_F(DenseComponentCollectionTest, SwapAndPopRemovalTest)
+{
+	CollectionType collection(k_testTypeId);
+	FillCollection(collection, 5);
+
+	collection.Destroy(1U);
+
+	ASSERT_EQ(collection.GetSize(), 4U);
+	EXPECT_EQ(collection.GetComponentsData()[1].value, 4);
+	EXPECT_EQ(collection.GetEntitiesData()[1], 4);
+	EXPECT_EQ(collection.GetControlBlock(1U)->dataIndex, 1);
+	EXPECT_EQ(collection.GetByEntity(1), nullptr);
+	EXPECT_EQ(collection.GetByEntity(4)->value, 4);
+}
+
+TEST_F(DenseComponentCollectionTest, DetachRemovesEntityMappingTest)
+{
+	CollectionType collection(k_testTypeId);
+	FillCollection(collection, 3);
+
+	collection.OnComponentEntityChanged(2U, ecs::Entity::GetInvalidId());
+
+	EXPECT_EQ(collection.GetByEntity(2), nullptr);
+	EXPECT_EQ(collection.GetEntitiesData()[2], ecs::Entity::GetInvalidId());
+	EXPECT_EQ(collection.GetSize(), 3U);
+}
+
+// Batch destruction must remove requested components, even when removal moves other requested components
+TEST_F(DenseComponentCollectionTest, BatchCreationAndDestructionTest)
+{
+	CollectionType collection(k_testTypeId);
+
+	ecs::ComponentPtr handles[6];
+	collection.CreateComponents(6U, handles);
+	for (int i = 0; i < 6; ++i)
+	{
+		collection.GetComponentsData()[i].value = i;
+	}
+
+	const std::size_t destroyedIndexes[] = { 1U, 5U, 4U };
+	collection.DestroyComponents(destroyedIndexes, 3U);
+
+	ASSERT_EQ(collection.GetSize(), 3U);
+	for (std::size_t i = 0U; i < collection.GetSize(); ++i)
+	{
+		const int value = collection.GetComponentsData()[i].value;
+		EXPECT_TRUE(value == 0 || value == 2 || value == 3);
+		EXPECT_EQ(collection.GetControlBlock(i)->dataIndex, static_cast<int32_t>(i));
+	}
+}
+
+// Cached component addresses must follow components, moved by removal, swaps and dense array reallocation
+TEST_F(DenseComponentCollectionTest, CachedDataPointersTest)
+{
+	CollectionType collection(k_testTypeId);
+	FillCollection(collection, 100);
+
+	collection.Destroy(1U);
+	collection.SwapSlots(2U, 50U);
+	collection.Compact();
+
+	for (std::size_t i = 0U; i < collection.GetSize(); ++i)
+	{
+		EXPECT_EQ(collection.GetControlBlock(i)->data, collection.GetData(i));
+	}
+}
+
+} // namespace
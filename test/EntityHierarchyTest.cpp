@@ -0,0 +1,295 @@
+#include <ecs/Manager.hpp>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace test
+{
+
+class EntityHierarchyTest
+	: public ::testing::Test
+{
+protected:
+	EntityHierarchyTest()
+	{
+		ecs::Manager::InitECSManager();
+		manager = ecs::Manager::Get();
+		manager->Init();
+	}
+
+	~EntityHierarchyTest() override
+	{
+		ecs::Manager::ShutdownECSManager();
+	}
+
+	std::vector<ecs::Entity> AddChildren(ecs::Entity& parent, const std::size_t count)
+	{
+		std::vector<ecs::Entity> children;
+		for (std::size_t i = 0U; i < count; ++i)
+		{
+			children.push_back(manager->CreateEntity());
+			parent.AddChild(children.back());
+		}
+
+		return children;
+	}
+
+	// Checks children order, and their parent links
+	void ExpectChildren(const ecs::Entity& parent, const std::vector<ecs::Entity>& children)
+	{
+		ASSERT_EQ(parent.GetChildrenCount(), children.size());
+		for (std::size_t i = 0U; i < children.size(); ++i)
+		{
+			EXPECT_EQ(parent.GetChildByIdx(i), children[i]);
+			EXPECT_EQ(children[i].GetParent(), parent);
+			EXPECT_EQ(children[i].GetOrderInParent(), i);
+		}
+	}
+
+	ecs::Manager* manager = nullptr;
+};
+
+TEST_F(EntityHierarchyTest, AddRemoveKeepsSiblingsOrder)
+{
+	ecs::Entity parent = manager->CreateEntity();
+	std::vector<ecs::Entity> children = AddChildren(parent, 5U);
+	ExpectChildren(parent, children);
+
+	// Following siblings are shifted, when the middle child is removed
+	parent.RemoveChild(children[2]);
+	EXPECT_FALSE(children[2].GetParent());
+	EXPECT_EQ(children[2].GetDepth(), 0U);
+	ExpectChildren(parent, { children[0], children[1], children[3], children[4] });
+
+	parent.RemoveChild(children[0]);
+	parent.RemoveChild(children[4]);
+	ExpectChildren(parent, { children[1], children[3] });
+	EXPECT_EQ(parent.GetChildren().size(), 2U);
+}
+
+TEST_F(EntityHierarchyTest, RemoveNotOwnChild)
+{
+	ecs::Entity parent = manager->CreateEntity();
+	ecs::Entity otherParent = manager->CreateEntity();
+	std::vector<ecs::Entity> children = AddChildren(parent, 2U);
+
+	otherParent.RemoveChild(children[0]);
+	ExpectChildren(parent, children);
+	EXPECT_EQ(otherParent.GetChildrenCount(), 0U);
+}
+
+TEST_F(EntityHierarchyTest, Reparent)
+{
+	ecs::Entity firstParent = manager->CreateEntity();
+	ecs::Entity secondParent = manager->CreateEntity();
+	std::vector<ecs::Entity> firstChildren = AddChildren(firstParent, 3U);
+	std::vector<ecs::Entity> secondChildren = AddChildren(secondParent, 1U);
+
+	// Attached child is moved from its previous parent
+	secondParent.AddChild(firstChildren[0]);
+	ExpectChildren(firstParent, { firstChildren[1], firstChildren[2] });
+	ExpectChildren(secondParent, { secondChildren[0], firstChildren[0] });
+
+	// Re-adding to the same parent moves child to the end
+	secondParent.AddChild(secondChildren[0]);
+	ExpectChildren(secondParent, { firstChildren[0], secondChildren[0] });
+
+	// Moved child is still referenced only by its parent
+	const ecs::EntityId movedId = firstChildren[0].GetId();
+	firstChildren[0].Reset();
+	secondParent.ClearChildren();
+	EXPECT_FALSE(manager->GetEntityById(movedId));
+}
+
+TEST_F(EntityHierarchyTest, RejectCycle)
+{
+	ecs::Entity root = manager->CreateEntity();
+	ecs::Entity child = manager->CreateEntity();
+	ecs::Entity grandChild = manager->CreateEntity();
+	root.AddChild(child);
+	child.AddChild(grandChild);
+
+	// Attaching to a descendant asserts in debug builds, and is ignored in release builds
+	EXPECT_DEBUG_DEATH(grandChild.AddChild(root), "");
+	EXPECT_DEBUG_DEATH(root.AddChild(root), "");
+
+	EXPECT_FALSE(root.GetParent());
+	ExpectChildren(root, { child });
+	ExpectChildren(child, { grandChild });
+	EXPECT_EQ(grandChild.GetChildrenCount(), 0U);
+	EXPECT_EQ(grandChild.GetDepth(), 2U);
+}
+
+TEST_F(EntityHierarchyTest, MovedSubtreeDepth)
+{
+	ecs::Entity root = manager->CreateEntity();
+	ecs::Entity deepParent = manager->CreateEntity();
+	root.AddChild(deepParent);
+
+	// Subtree with two branches of different depth
+	ecs::Entity subtree = manager->CreateEntity();
+	std::vector<ecs::Entity> branches = AddChildren(subtree, 2U);
+	std::vector<ecs::Entity> leaves = AddChildren(branches[0], 2U);
+	ecs::Entity deepLeaf = manager->CreateEntity();
+	leaves[1].AddChild(deepLeaf);
+	EXPECT_EQ(deepLeaf.GetDepth(), 3U);
+
+	deepParent.AddChild(subtree);
+	EXPECT_EQ(subtree.GetDepth(), 2U);
+	EXPECT_EQ(branches[0].GetDepth(), 3U);
+	EXPECT_EQ(branches[1].GetDepth(), 3U);
+	EXPECT_EQ(leaves[0].GetDepth(), 4U);
+	EXPECT_EQ(leaves[1].GetDepth(), 4U);
+	EXPECT_EQ(deepLeaf.GetDepth(), 5U);
+
+	// Moving a branch closer to the root shifts only its own subtree
+	root.AddChild(branches[0]);
+	EXPECT_EQ(branches[0].GetDepth(), 1U);
+	EXPECT_EQ(leaves[1].GetDepth(), 2U);
+	EXPECT_EQ(deepLeaf.GetDepth(), 3U);
+	EXPECT_EQ(branches[1].GetDepth(), 3U);
+
+	root.RemoveChild(branches[0]);
+	EXPECT_EQ(branches[0].GetDepth(), 0U);
+	EXPECT_EQ(leaves[0].GetDepth(), 1U);
+	EXPECT_EQ(deepLeaf.GetDepth(), 2U);
+}
+
+TEST_F(EntityHierarchyTest, ChildrenLiveWhileAttached)
+{
+	ecs::Entity parent = manager->CreateEntity();
+	ecs::EntityId childId = ecs::Entity::GetInvalidId();
+	ecs::EntityId grandChildId = ecs::Entity::GetInvalidId();
+	{
+		ecs::Entity child = manager->CreateEntity();
+		ecs::Entity grandChild = manager->CreateEntity();
+		parent.AddChild(child);
+		child.AddChild(grandChild);
+		childId = child.GetId();
+		grandChildId = grandChild.GetId();
+	}
+
+	// Parent keeps references of the whole subtree
+	ecs::Entity child = manager->GetEntityById(childId);
+	ASSERT_TRUE(child);
+	EXPECT_EQ(child.GetParent(), parent);
+	ASSERT_TRUE(manager->GetEntityById(grandChildId));
+
+	// Removed child is kept alive by the local handle only
+	parent.RemoveChild(child);
+	EXPECT_TRUE(manager->GetEntityById(childId));
+	child.Reset();
+	EXPECT_FALSE(manager->GetEntityById(childId));
+	EXPECT_FALSE(manager->GetEntityById(grandChildId));
+}
+
+TEST_F(EntityHierarchyTest, DestroyedParentReleasesChildren)
+{
+	ecs::Entity parent = manager->CreateEntity();
+	std::vector<ecs::Entity> children = AddChildren(parent, 3U);
+	const ecs::EntityId releasedId = children[0].GetId();
+	children[0].Reset();
+
+	parent.Reset();
+	EXPECT_FALSE(manager->GetEntityById(releasedId));
+	for (std::size_t i = 1U; i < children.size(); ++i)
+	{
+		EXPECT_FALSE(children[i].GetParent());
+		EXPECT_EQ(children[i].GetDepth(), 0U);
+	}
+}
+
+TEST_F(EntityHierarchyTest, ClearChildren)
+{
+	ecs::Entity parent = manager->CreateEntity();
+	std::vector<ecs::Entity> children = AddChildren(parent, 4U);
+	AddChildren(children[0], 2U);
+	ecs::EntityId releasedId = ecs::Entity::GetInvalidId();
+	{
+		ecs::Entity released = manager->CreateEntity();
+		parent.AddChild(released);
+		releasedId = released.GetId();
+	}
+	ASSERT_EQ(parent.GetChildrenCount(), 5U);
+
+	parent.ClearChildren();
+	EXPECT_EQ(parent.GetChildrenCount(), 0U);
+	EXPECT_FALSE(manager->GetEntityById(releasedId));
+	for (const ecs::Entity& child : children)
+	{
+		EXPECT_FALSE(child.GetParent());
+		EXPECT_EQ(child.GetOrderInParent(), uint32_t(-1));
+		EXPECT_EQ(child.GetDepth(), 0U);
+	}
+	EXPECT_EQ(children[0].GetChildrenCount(), 2U);
+	EXPECT_EQ(children[0].GetChildByIdx(1U).GetDepth(), 1U);
+
+	// Cleared parent gets a new children block
+	std::vector<ecs::Entity> newChildren = AddChildren(parent, 3U);
+	ExpectChildren(parent, newChildren);
+}
+
+TEST_F(EntityHierarchyTest, FreedChildrenBlocksReuse)
+{
+	ecs::Entity firstParent = manager->CreateEntity();
+	ecs::Entity secondParent = manager->CreateEntity();
+
+	// Parents grow in turns, so every grown block takes a block freed by the other parent
+	std::vector<ecs::Entity> firstChildren;
+	std::vector<ecs::Entity> secondChildren;
+	for (int i = 0; i < 40; ++i)
+	{
+		std::vector<ecs::Entity> added = AddChildren(firstParent, 1U);
+		firstChildren.push_back(added[0]);
+		added = AddChildren(secondParent, 1U);
+		secondChildren.push_back(added[0]);
+	}
+	ExpectChildren(firstParent, firstChildren);
+	ExpectChildren(secondParent, secondChildren);
+
+	// Freed blocks are reused by other parents, without overwriting children of the alive blocks
+	firstParent.ClearChildren();
+	ecs::Entity thirdParent = manager->CreateEntity();
+	std::vector<ecs::Entity> thirdChildren = AddChildren(thirdParent, 40U);
+	std::vector<ecs::Entity> refilledChildren = AddChildren(firstParent, 20U);
+
+	ExpectChildren(secondParent, secondChildren);
+	ExpectChildren(thirdParent, thirdChildren);
+	ExpectChildren(firstParent, refilledChildren);
+}
+
+TEST_F(EntityHierarchyTest, ForEachInSubtree)
+{
+	ecs::Entity parent = manager->CreateEntity();
+	std::vector<ecs::Entity> roots = AddChildren(parent, 2U);
+	std::vector<ecs::Entity> branches = AddChildren(roots[0], 2U);
+	std::vector<ecs::Entity> leaves = AddChildren(branches[0], 2U);
+	AddChildren(roots[1], 1U);
+
+	// Walk visits parents before children, and stops at the end of the subtree, without going to root siblings
+	std::vector<ecs::Entity> visited;
+	manager->ForEachInHierarchy(roots[0], [&visited](ecs::Entity& entity)
+	{
+		visited.push_back(entity);
+	});
+
+	const std::vector<ecs::Entity> expected = { roots[0], branches[0], leaves[0], leaves[1], branches[1] };
+	EXPECT_EQ(visited, expected);
+}
+
+TEST_F(EntityHierarchyTest, ChildrenBeyondSixteenBitOrder)
+{
+	const std::size_t childrenCount = 70000U;
+
+	ecs::Entity parent = manager->CreateEntity();
+	std::vector<ecs::Entity> children = AddChildren(parent, childrenCount);
+	ASSERT_EQ(parent.GetChildrenCount(), childrenCount);
+	EXPECT_EQ(parent.GetChildByIdx(childrenCount - 1U), children.back());
+	EXPECT_EQ(children.back().GetOrderInParent(), childrenCount - 1U);
+
+	parent.RemoveChild(children[1]);
+	EXPECT_EQ(parent.GetChildByIdx(childrenCount - 2U), children.back());
+	EXPECT_EQ(children.back().GetOrderInParent(), childrenCount - 2U);
+}
+
+} // namespace test
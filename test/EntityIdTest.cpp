@@ -0,0 +1,99 @@
+#include <ecs/Manager.hpp>
+#include <ecs/detail/EntityIdBits.hpp>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace test
+{
+
+struct IdHealth
+{
+	int value;
+};
+
+class EntityIdTest
+	: public ::testing::Test
+{
+protected:
+	EntityIdTest()
+	{
+		ecs::Manager::InitECSManager();
+		manager = ecs::Manager::Get();
+
+		manager->RegisterComponentType<IdHealth>("IdHealth");
+		manager->Init();
+	}
+
+	~EntityIdTest() override
+	{
+		ecs::Manager::ShutdownECSManager();
+	}
+
+	ecs::Manager* manager = nullptr;
+};
+
+TEST(EntityIdBitsTest, IndexAndGeneration)
+{
+	const ecs::EntityId id = ecs::detail::MakeEntityId(12345U, 0xABCDEF01U);
+	EXPECT_GE(id, 0);
+	EXPECT_EQ(ecs::detail::GetEntityIndex(id), 12345U);
+	EXPECT_EQ(ecs::detail::GetEntityGeneration(id), 0xABCDEF01U);
+
+	// The highest index is reserved, so valid ids never match invalid id
+	const ecs::EntityId lastId = ecs::detail::MakeEntityId(ecs::detail::k_maxEntitiesCount - 1U, ecs::detail::k_entityGenerationMask);
+	EXPECT_NE(lastId, ecs::Entity::GetInvalidId());
+	EXPECT_GE(lastId, 0);
+}
+
+TEST_F(EntityIdTest, StaleIdAfterLocationReuse)
+{
+	ecs::Entity entity = manager->CreateEntity();
+	const ecs::EntityId firstId = entity.GetId();
+	entity.Reset();
+
+	// Hot location is reused by every created entity, far beyond the generations count of narrow ids
+	std::vector<ecs::EntityId> staleIds;
+	for (int i = 0; i < 5000; ++i)
+	{
+		ecs::Entity recreated = manager->CreateEntity();
+		ASSERT_EQ(ecs::detail::GetEntityIndex(recreated.GetId()), ecs::detail::GetEntityIndex(firstId));
+		ASSERT_NE(recreated.GetId(), firstId);
+
+		if (i % 1000 == 0)
+		{
+			staleIds.push_back(recreated.GetId());
+		}
+	}
+
+	ecs::Entity alive = manager->CreateEntity();
+	alive.AddComponent(manager->CreateComponent<IdHealth>(1));
+	EXPECT_EQ(ecs::detail::GetEntityIndex(alive.GetId()), ecs::detail::GetEntityIndex(firstId));
+
+	EXPECT_FALSE(manager->GetEntityById(firstId));
+	for (const ecs::EntityId staleId : staleIds)
+	{
+		EXPECT_FALSE(manager->GetEntityById(staleId));
+	}
+	EXPECT_EQ(manager->GetEntityById(alive.GetId()), alive);
+}
+
+TEST_F(EntityIdTest, ComponentEntityId)
+{
+	ecs::Entity entity = manager->CreateEntity();
+	ecs::TComponentPtr<IdHealth> health = manager->CreateComponent<IdHealth>(5);
+	entity.AddComponent(health);
+	EXPECT_EQ(health.GetEntity(), entity);
+
+	const ecs::EntityId entityId = entity.GetId();
+	entity.Reset();
+	EXPECT_FALSE(manager->GetEntityById(entityId));
+	EXPECT_FALSE(health.GetEntity());
+
+	// Entity, which reuses the location, doesn't own the component
+	ecs::Entity otherEntity = manager->CreateEntity();
+	EXPECT_EQ(ecs::detail::GetEntityIndex(otherEntity.GetId()), ecs::detail::GetEntityIndex(entityId));
+	EXPECT_FALSE(health.GetEntity());
+}
+
+} // namespace test
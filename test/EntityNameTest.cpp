@@ -0,0 +1,157 @@
+#include <ecs/Manager.hpp>
+#include <ecs/detail/EntityIdBits.hpp>
+#include <gtest/gtest.h>
+
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace test
+{
+
+// Counts allocations of entity names, passed to the upstream resource
+class NameCountingResource
+	: public std::pmr::memory_resource
+{
+public:
+	int allocationsCount = 0;
+	int liveAllocationsCount = 0;
+
+private:
+	void* do_allocate(const std::size_t bytes, const std::size_t alignment) override
+	{
+		++allocationsCount;
+		++liveAllocationsCount;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void* p, const std::size_t bytes, const std::size_t alignment) override
+	{
+		--liveAllocationsCount;
+		std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+	{
+		return this == &other;
+	}
+};
+
+class EntityNameTest
+	: public ::testing::Test
+{
+protected:
+	EntityNameTest()
+	{
+		ecs::Manager::InitECSManager();
+		manager = ecs::Manager::Get();
+		manager->Init();
+	}
+
+	~EntityNameTest() override
+	{
+		ecs::Manager::ShutdownECSManager();
+	}
+
+	ecs::Manager* manager = nullptr;
+};
+
+TEST_F(EntityNameTest, SetGetName)
+{
+	ecs::Entity entity = manager->CreateEntity();
+	EXPECT_TRUE(entity.GetName().empty());
+
+	entity.SetName("Player");
+	EXPECT_EQ(entity.GetName(), "Player");
+
+	std::string name = "Enemy";
+	entity.SetName(std::move(name));
+	EXPECT_EQ(entity.GetName(), "Enemy");
+
+	entity.SetName("");
+	EXPECT_TRUE(entity.GetName().empty());
+}
+
+TEST_F(EntityNameTest, NameIsResetForReusedLocation)
+{
+	ecs::Entity first = manager->CreateEntity();
+	ecs::Entity second = manager->CreateEntity();
+	first.SetName("First");
+	second.SetName("Second");
+
+	const ecs::EntityId firstId = first.GetId();
+	first.Reset();
+
+	// Destroyed entity location is reused by the next entity, which must not inherit the name
+	ecs::Entity reused = manager->CreateEntity();
+	ASSERT_EQ(ecs::detail::GetEntityIndex(reused.GetId()), ecs::detail::GetEntityIndex(firstId));
+	EXPECT_TRUE(reused.GetName().empty());
+	EXPECT_EQ(second.GetName(), "Second");
+
+	reused.SetName("Reused");
+	EXPECT_EQ(reused.GetName(), "Reused");
+	EXPECT_EQ(second.GetName(), "Second");
+}
+
+TEST_F(EntityNameTest, NamesOfManyEntities)
+{
+	std::vector<ecs::Entity> entities;
+	for (int i = 0; i < 3000; ++i)
+	{
+		entities.push_back(manager->CreateEntity());
+		entities.back().SetName("Entity" + std::to_string(i));
+	}
+
+	// Destroy every second entity, and refill their locations
+	for (std::size_t i = 0U; i < entities.size(); i += 2U)
+	{
+		entities[i].Reset();
+	}
+	for (std::size_t i = 0U; i < entities.size(); i += 2U)
+	{
+		entities[i] = manager->CreateEntity();
+	}
+
+	for (std::size_t i = 0U; i < entities.size(); ++i)
+	{
+		if (i % 2U == 0U)
+		{
+			EXPECT_TRUE(entities[i].GetName().empty());
+		}
+		else
+		{
+			EXPECT_EQ(entities[i].GetName(), "Entity" + std::to_string(i));
+		}
+	}
+}
+
+// Names are allocated from the manager memory resource, and released with their entities
+TEST(EntityNameResourceTest, NameAllocatedFromManagerResource)
+{
+	NameCountingResource resource;
+	ecs::Manager::InitECSManager(&resource);
+	ecs::Manager* manager = ecs::Manager::Get();
+	manager->Init();
+
+	const std::string longName(100U, 'n');
+	ecs::Entity entity = manager->CreateEntity();
+
+	const int allocationsCount = resource.allocationsCount;
+	entity.SetName(longName);
+	EXPECT_EQ(resource.allocationsCount, allocationsCount + 1);
+	EXPECT_EQ(entity.GetName(), longName);
+
+	ecs::Entity clone = entity.Clone();
+	EXPECT_EQ(clone.GetName(), longName);
+	clone.Reset();
+
+	// Destroyed entity frees its name
+	const int liveAllocationsCount = resource.liveAllocationsCount;
+	entity.Reset();
+	EXPECT_EQ(resource.liveAllocationsCount, liveAllocationsCount - 1);
+
+	ecs::Manager::ShutdownECSManager();
+	EXPECT_EQ(resource.liveAllocationsCount, 0);
+}
+
+} // namespace test
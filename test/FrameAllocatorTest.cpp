@@ -0,0 +1,72 @@
+#include <ecs/storage/FrameAllocator.hpp>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory_resource>
+
+namespace test
+{
+
+const std::size_t k_testBlockSize = 1024U;
+
+class FrameAllocatorTest
+	: public ::testing::Test
+{
+protected:
+	FrameAllocatorTest()
+		: frameAllocator(k_testBlockSize)
+	{}
+
+	ecs::FrameAllocator frameAllocator;
+};
+
+// Allocations must be aligned and laid out linearly inside a block
+TEST_F(FrameAllocatorTest, LinearAllocationTest)
+{
+	char* first = static_cast<char*>(frameAllocator.Allocate(3U, 1U));
+	char* second = static_cast<char*>(frameAllocator.Allocate(3U, 1U));
+	void* aligned = frameAllocator.Allocate(16U, 64U);
+
+	EXPECT_EQ(second, first + 3);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 64U, 0U);
+	EXPECT_EQ(frameAllocator.GetBlocksCount(), 1U);
+}
+
+// Reset must reuse blocks of previous frames, so steady state frames don't request new blocks
+TEST_F(FrameAllocatorTest, ResetReusesBlocksTest)
+{
+	void* firstFrameStart = nullptr;
+	for (int frame = 0; frame < 3; ++frame)
+	{
+		void* frameStart = frameAllocator.Allocate(k_testBlockSize / 2U);
+		frameAllocator.Allocate(k_testBlockSize / 2U);
+		frameAllocator.Allocate(k_testBlockSize * 4U);
+
+		if (nullptr == firstFrameStart)
+		{
+			firstFrameStart = frameStart;
+		}
+
+		EXPECT_EQ(frameStart, firstFrameStart);
+		EXPECT_EQ(frameAllocator.GetBlocksCount(), 2U);
+
+		frameAllocator.Reset();
+	}
+}
+
+// Standard containers must be able to use allocator through STL adaptor and as memory resource
+TEST_F(FrameAllocatorTest, ContainersTest)
+{
+	ecs::FrameVector<int> values{ ecs::FrameStlAllocator<int>(frameAllocator) };
+	std::pmr::vector<int> pmrValues(&frameAllocator);
+
+	for (int i = 0; i < 100; ++i)
+	{
+		values.push_back(i);
+		pmrValues.push_back(i);
+	}
+
+	EXPECT_EQ(values[99], 99);
+	EXPECT_EQ(pmrValues[99], 99);
+}
+
+} // namespace
@@ -0,0 +1,66 @@
+#include <ecs/component/HashMapComponentCollection.hpp>
+#include <gtest/gtest.h>
+
+namespace test
+{
+
+struct RareTestComponent
+{
+	int value;
+};
+
+const ecs::ComponentTypeId k_testTypeId = 0;
+
+class HashMapComponentCollectionTest
+	: public ::testing::Test
+{
+protected:
+	using CollectionType = ecs::HashMapComponentCollection<RareTestComponent>;
+};
+
+// Components must keep their addresses and indexes, while other components are created and destroyed
+TEST_F(HashMapComponentCollectionTest, StableDataTest)
+{
+	CollectionType collection(k_testTypeId);
+	for (int i = 0; i < 5; ++i)
+	{
+		collection.Emplace(i);
+	}
+
+	void* keptData = collection.GetData(3U);
+	for (int i = 5; i < 100; ++i)
+	{
+		collection.Emplace(i);
+	}
+
+	EXPECT_EQ(collection.GetData(3U), keptData);
+	EXPECT_EQ(collection.GetControlBlock(3U)->dataIndex, 3);
+	EXPECT_EQ(static_cast<RareTestComponent*>(keptData)->value, 3);
+	EXPECT_EQ(collection.GetSize(), 100U);
+}
+
+// Indexes of destroyed components must be reused by new components
+TEST_F(HashMapComponentCollectionTest, IndexReuseTest)
+{
+	CollectionType collection(k_testTypeId);
+	for (int i = 0; i < 3; ++i)
+	{
+		collection.Emplace(i);
+	}
+
+	collection.Destroy(1U);
+	EXPECT_EQ(collection.GetSize(), 2U);
+
+	collection.Emplace(10);
+	EXPECT_EQ(collection.GetControlBlock(1U)->dataIndex, 1);
+	EXPECT_EQ(static_cast<RareTestComponent*>(collection.GetData(1U))->value, 10);
+
+	int visitedCount = 0;
+	for (auto it = collection.begin(); it != collection.end(); ++it)
+	{
+		++visitedCount;
+	}
+	EXPECT_EQ(visitedCount, 3);
+}
+
+} // namespace
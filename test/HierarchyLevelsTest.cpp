@@ -0,0 +1,170 @@
+#include <ecs/Manager.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace test
+{
+
+class HierarchyLevelsTest
+	: public ::testing::Test
+{
+protected:
+	HierarchyLevelsTest()
+	{
+		ecs::Manager::InitECSManager();
+		manager = ecs::Manager::Get();
+		manager->Init();
+	}
+
+	~HierarchyLevelsTest() override
+	{
+		ecs::Manager::ShutdownECSManager();
+	}
+
+	ecs::Entity CreateChild(ecs::Entity& parent)
+	{
+		ecs::Entity child = manager->CreateEntity();
+		parent.AddChild(child);
+		return child;
+	}
+
+	// Parent id of every entity, grouped by levels
+	std::vector<std::map<ecs::EntityId, ecs::EntityId>> CollectLevels()
+	{
+		std::vector<std::map<ecs::EntityId, ecs::EntityId>> levels;
+		manager->ForEachHierarchyLevel([&levels](const uint16_t depth, const std::size_t count, const ecs::EntityId* entities, const ecs::EntityId* parents)
+		{
+			EXPECT_EQ(depth, levels.size());
+			levels.emplace_back();
+			for (std::size_t i = 0U; i < count; ++i)
+			{
+				EXPECT_TRUE(levels.back().emplace(entities[i], parents[i]).second);
+			}
+		});
+
+		return levels;
+	}
+
+	// Checks levels against the entities hierarchy, every entity must be in the level of its depth, next to its parent
+	void ExpectLevels(const std::vector<std::vector<ecs::Entity>>& expectedLevels)
+	{
+		const std::vector<std::map<ecs::EntityId, ecs::EntityId>> levels = CollectLevels();
+		ASSERT_EQ(levels.size(), expectedLevels.size());
+
+		for (std::size_t depth = 0U; depth < levels.size(); ++depth)
+		{
+			ASSERT_EQ(levels[depth].size(), expectedLevels[depth].size());
+			for (const ecs::Entity& entity : expectedLevels[depth])
+			{
+				const auto it = levels[depth].find(entity.GetId());
+				ASSERT_NE(it, levels[depth].end());
+				EXPECT_EQ(entity.GetDepth(), depth);
+				EXPECT_EQ(it->second, entity.GetParent().GetId());
+			}
+
+			for (const auto& entityParent : levels[depth])
+			{
+				if (0U == depth)
+				{
+					EXPECT_EQ(entityParent.second, ecs::Entity::GetInvalidId());
+				}
+				else
+				{
+					EXPECT_EQ(levels[depth - 1U].count(entityParent.second), 1U);
+				}
+			}
+		}
+	}
+
+	ecs::Manager* manager = nullptr;
+};
+
+TEST_F(HierarchyLevelsTest, EmptyHierarchy)
+{
+	EXPECT_TRUE(CollectLevels().empty());
+}
+
+TEST_F(HierarchyLevelsTest, BuildTree)
+{
+	ecs::Entity root = manager->CreateEntity();
+	ecs::Entity otherRoot = manager->CreateEntity();
+	ecs::Entity first = CreateChild(root);
+	ecs::Entity second = CreateChild(root);
+	ecs::Entity third = CreateChild(otherRoot);
+	ecs::Entity firstLeaf = CreateChild(first);
+	ecs::Entity secondLeaf = CreateChild(second);
+	ecs::Entity deepLeaf = CreateChild(secondLeaf);
+
+	ExpectLevels({ { root, otherRoot }, { first, second, third }, { firstLeaf, secondLeaf }, { deepLeaf } });
+}
+
+TEST_F(HierarchyLevelsTest, ReparentSubtree)
+{
+	ecs::Entity root = manager->CreateEntity();
+	ecs::Entity first = CreateChild(root);
+	ecs::Entity second = CreateChild(root);
+	ecs::Entity deep = CreateChild(second);
+	ecs::Entity subtree = CreateChild(first);
+	ecs::Entity leaf = CreateChild(subtree);
+	ecs::Entity otherLeaf = CreateChild(subtree);
+	ExpectLevels({ { root }, { first, second }, { deep, subtree }, { leaf, otherLeaf } });
+
+	// Subtree moves one level deeper
+	deep.AddChild(subtree);
+	ExpectLevels({ { root }, { first, second }, { deep }, { subtree }, { leaf, otherLeaf } });
+
+	// Subtree moves up, next to the previous parent of the former sibling
+	root.AddChild(subtree);
+	ExpectLevels({ { root }, { first, second, subtree }, { deep, leaf, otherLeaf } });
+
+	// Leaf moves between parents of the same level
+	first.AddChild(leaf);
+	ExpectLevels({ { root }, { first, second, subtree }, { deep, leaf, otherLeaf } });
+}
+
+TEST_F(HierarchyLevelsTest, DetachSubtree)
+{
+	ecs::Entity root = manager->CreateEntity();
+	ecs::Entity subtree = CreateChild(root);
+	ecs::Entity sibling = CreateChild(root);
+	ecs::Entity child = CreateChild(subtree);
+	ecs::Entity leaf = CreateChild(child);
+	ExpectLevels({ { root }, { subtree, sibling }, { child }, { leaf } });
+
+	root.RemoveChild(subtree);
+	ExpectLevels({ { root, subtree }, { sibling, child }, { leaf } });
+
+	subtree.ClearChildren();
+	ExpectLevels({ { root, subtree, child }, { sibling, leaf } });
+}
+
+TEST_F(HierarchyLevelsTest, DestroyMidLevelEntity)
+{
+	ecs::Entity root = manager->CreateEntity();
+	ecs::Entity kept = CreateChild(root);
+	ecs::Entity destroyed = CreateChild(root);
+	ecs::Entity keptLeaf = CreateChild(kept);
+	ecs::Entity orphan = CreateChild(destroyed);
+	ecs::Entity orphanLeaf = CreateChild(orphan);
+	ecs::EntityId releasedId = ecs::Entity::GetInvalidId();
+	{
+		ecs::Entity released = CreateChild(destroyed);
+		releasedId = released.GetId();
+	}
+	ExpectLevels({ { root }, { kept, destroyed }, { keptLeaf, orphan, manager->GetEntityById(releasedId) }, { orphanLeaf } });
+
+	// Destroyed entity releases its children, referenced children become roots with their subtrees
+	root.RemoveChild(destroyed);
+	destroyed.Reset();
+	EXPECT_FALSE(manager->GetEntityById(releasedId));
+	ExpectLevels({ { root, orphan }, { kept, orphanLeaf }, { keptLeaf } });
+
+	// Levels stay consistent, when the emptied slots are refilled
+	ecs::Entity added = CreateChild(orphanLeaf);
+	ExpectLevels({ { root, orphan }, { kept, orphanLeaf }, { keptLeaf, added } });
+}
+
+} // namespace test
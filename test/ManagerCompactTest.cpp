@@ -0,0 +1,197 @@
+#include <ecs/Manager.hpp>
+#include <ecs/detail/EntityIdBits.hpp>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+
+namespace test
+{
+
+struct CompactPooled
+{
+	int value;
+};
+
+struct CompactDense
+{
+	int value;
+};
+
+struct CompactOther
+{
+	int value;
+};
+
+} // namespace test
+
+ECS_COMPONENT_PAGED_STORAGE(test::CompactPooled, 4U)
+ECS_COMPONENT_STORAGE(test::CompactDense, ecs::DenseComponentCollection)
+
+namespace test
+{
+
+class ManagerCompactTest
+	: public ::testing::Test
+{
+protected:
+	ManagerCompactTest()
+	{
+		ecs::Manager::InitECSManager();
+		manager = ecs::Manager::Get();
+
+		manager->RegisterComponentType<CompactPooled>("CompactPooled");
+		manager->RegisterComponentType<CompactDense>("CompactDense");
+		manager->RegisterComponentType<CompactOther>("CompactOther");
+		manager->Init();
+	}
+
+	~ManagerCompactTest() override
+	{
+		ecs::Manager::ShutdownECSManager();
+	}
+
+	ecs::Entity CreateEntity(const int value)
+	{
+		ecs::Entity entity = manager->CreateEntity();
+		entity.AddComponent(manager->CreateComponent<CompactPooled>(value));
+		entity.AddComponent(manager->CreateComponent<CompactDense>(value));
+		return entity;
+	}
+
+	ecs::Manager* manager = nullptr;
+};
+
+TEST_F(ManagerCompactTest, TrimmedEntitiesStayStale)
+{
+	std::vector<ecs::Entity> entities;
+	for (int i = 0; i < 8; ++i)
+	{
+		entities.push_back(CreateEntity(i));
+	}
+
+	// Entities at the end of the storage are trimmed by compaction
+	std::vector<ecs::EntityId> staleIds;
+	for (std::size_t i = 5U; i < entities.size(); ++i)
+	{
+		staleIds.push_back(entities[i].GetId());
+		entities[i].Reset();
+	}
+
+	EXPECT_TRUE(manager->Compact());
+	for (const ecs::EntityId staleId : staleIds)
+	{
+		EXPECT_FALSE(manager->GetEntityById(staleId));
+	}
+
+	// Recreated entities take trimmed locations, but continue their generations
+	std::vector<ecs::Entity> recreated;
+	for (const ecs::EntityId staleId : staleIds)
+	{
+		recreated.push_back(CreateEntity(0));
+		EXPECT_EQ(ecs::detail::GetEntityIndex(recreated.back().GetId()), ecs::detail::GetEntityIndex(staleId));
+		EXPECT_NE(ecs::detail::GetEntityGeneration(recreated.back().GetId()), ecs::detail::GetEntityGeneration(staleId));
+	}
+	for (const ecs::EntityId staleId : staleIds)
+	{
+		EXPECT_FALSE(manager->GetEntityById(staleId));
+	}
+
+	for (std::size_t i = 0U; i < 5U; ++i)
+	{
+		EXPECT_EQ(manager->GetEntityById(entities[i].GetId()), entities[i]);
+		EXPECT_EQ(entities[i].GetComponent<CompactPooled>()->value, int(i));
+	}
+}
+
+TEST_F(ManagerCompactTest, TimeBudgetResumesPass)
+{
+	std::vector<ecs::Entity> entities;
+	for (int i = 0; i < 100; ++i)
+	{
+		entities.push_back(CreateEntity(i));
+	}
+	entities.resize(10U);
+
+	// Every call exceeds tiny budget after its first step, so the pass is finished by several calls
+	int callsCount = 1;
+	while (!manager->Compact(std::chrono::nanoseconds(1)))
+	{
+		++callsCount;
+		ASSERT_LT(callsCount, 100);
+	}
+	EXPECT_GT(callsCount, 1);
+
+	// Finished pass is started again by the next call
+	EXPECT_FALSE(manager->Compact(std::chrono::nanoseconds(1)));
+	EXPECT_TRUE(manager->Compact());
+	EXPECT_TRUE(manager->Compact());
+
+	for (std::size_t i = 0U; i < entities.size(); ++i)
+	{
+		EXPECT_EQ(entities[i].GetComponent<CompactDense>()->value, int(i));
+	}
+}
+
+TEST_F(ManagerCompactTest, HandlesResolveAfterRoomsRelease)
+{
+	std::vector<ecs::Entity> entities;
+	std::vector<ecs::TComponentHandle<CompactPooled>> pooledHandles;
+	std::vector<ecs::TComponentHandle<CompactDense>> denseHandles;
+	for (int i = 0; i < 256; ++i)
+	{
+		entities.push_back(CreateEntity(i));
+		pooledHandles.emplace_back(ecs::ComponentHandle(entities.back().GetComponent<CompactPooled>()));
+		denseHandles.emplace_back(ecs::ComponentHandle(entities.back().GetComponent<CompactDense>()));
+	}
+
+	// Most of the rooms become empty, survivors are spread over the storage
+	for (std::size_t i = 0U; i < entities.size(); ++i)
+	{
+		if (i % 64U != 0U)
+		{
+			entities[i].Reset();
+		}
+	}
+
+	EXPECT_TRUE(manager->Compact());
+
+	for (std::size_t i = 0U; i < entities.size(); ++i)
+	{
+		if (i % 64U == 0U)
+		{
+			ASSERT_NE(pooledHandles[i].Resolve(), nullptr);
+			EXPECT_EQ(pooledHandles[i]->value, int(i));
+			ASSERT_NE(denseHandles[i].Resolve(), nullptr);
+			EXPECT_EQ(denseHandles[i]->value, int(i));
+			EXPECT_EQ(pooledHandles[i].GetEntity(), entities[i]);
+		}
+		else
+		{
+			EXPECT_EQ(pooledHandles[i].Resolve(), nullptr);
+			EXPECT_EQ(denseHandles[i].Resolve(), nullptr);
+		}
+	}
+
+	// Released rooms are allocated again by new components
+	ecs::Entity entity = CreateEntity(1000);
+	entity.AddComponent(manager->CreateComponent<CompactOther>(1001));
+	EXPECT_EQ(entity.GetComponent<CompactPooled>()->value, 1000);
+	EXPECT_EQ(pooledHandles[64]->value, 64);
+}
+
+TEST_F(ManagerCompactTest, ReleasesFrameAllocatorBlocks)
+{
+	ecs::FrameAllocator& frameAllocator = manager->GetFrameAllocator();
+	EXPECT_NE(frameAllocator.Allocate(1024U), nullptr);
+	ASSERT_GT(frameAllocator.GetBlocksCount(), 0U);
+
+	EXPECT_TRUE(manager->Compact());
+	EXPECT_EQ(frameAllocator.GetBlocksCount(), 0U);
+
+	// Next frames allocate blocks again
+	EXPECT_NE(frameAllocator.Allocate(1024U), nullptr);
+	EXPECT_GT(frameAllocator.GetBlocksCount(), 0U);
+}
+
+} // namespace test
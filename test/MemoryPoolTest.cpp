@@ -1,5 +1,8 @@
-#include <storage/MemoryPool.hpp>
+#include <ecs/storage/MemoryPool.hpp>
 #include <gtest/gtest.h>
+#include <array>
+#include <memory_resource>
+#include <string>
 
 namespace test
 {
@@ -11,6 +14,11 @@ struct TestObject
 	char c = 'W';
 };
 
+struct alignas(32) AlignedTestObject
+{
+	float values[8];
+};
+
 const std::size_t k_defaultChunkSize = 64U;
 
 class MemoryPoolTest
@@ -131,4 +139,106 @@ TEST_F(MemoryPoolTest, IteratorWithRemovalTest)
 	EXPECT_EQ(iteratedCount, pool.GetItemsCount());
 }
 
+// Chunks must honour both policy alignment and type alignment
+TEST_F(MemoryPoolTest, ChunkAlignmentTest)
+{
+	ecs::AllocationPolicy policy;
+	policy.alignment = 128U;
+
+	auto pool = ecs::detail::MemoryPool<AlignedTestObject>(k_defaultChunkSize, policy);
+	auto result = pool.CreateItem();
+
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(result.second) % 128U, 0U);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(pool.CreateItem().second) % alignof(AlignedTestObject), 0U);
+}
+
+// Chunk size derived from policy must fill whole pages
+TEST_F(MemoryPoolTest, PageSizedChunkTest)
+{
+	ecs::AllocationPolicy policy;
+	auto pool = ecs::detail::MemoryPool<TestObject>(policy);
+	pool.CreateItem();
+
+	const std::size_t chunkBytes = ecs::detail::GetChunkBytes(policy, sizeof(TestObject));
+	EXPECT_EQ(chunkBytes % ecs::detail::GetPageSize(policy), 0U);
+	EXPECT_GE(chunkBytes, policy.minChunkBytes);
+	EXPECT_EQ(pool.GetAllocatedCount(), chunkBytes / sizeof(TestObject));
+}
+
+// Batch removal must fill the gap with the pool tail, crossing chunk boundaries
+TEST_F(MemoryPoolTest, BatchDestructionTest)
+{
+	auto pool = ecs::detail::MemoryPool<TestObject>(k_defaultChunkSize);
+	const int itemsCount = static_cast<int>(k_defaultChunkSize) * 3;
+	for (int i = 0; i < itemsCount; ++i)
+	{
+		pool.CreateItem().second->a = i;
+	}
+
+	const std::size_t removedStart = k_defaultChunkSize / 2U;
+	const std::size_t removedCount = k_defaultChunkSize;
+	pool.DestroyItems(removedStart, removedCount);
+
+	ASSERT_EQ(pool.GetItemsCount(), itemsCount - removedCount);
+	EXPECT_EQ(pool[removedStart - 1U]->a, static_cast<int>(removedStart) - 1);
+	EXPECT_EQ(pool[removedStart]->a, itemsCount - static_cast<int>(removedCount));
+	EXPECT_EQ(pool[removedStart + removedCount - 1U]->a, itemsCount - 1);
+	EXPECT_EQ(pool[removedStart + removedCount]->a, static_cast<int>(removedStart + removedCount));
+}
+
+// Non trivially relocatable items must be move constructed into destroyed slot
+TEST_F(MemoryPoolTest, NonTrivialItemRelocationTest)
+{
+	auto pool = ecs::detail::MemoryPool<std::string>(k_defaultChunkSize);
+	for (int i = 0; i < 3; ++i)
+	{
+		*pool.CreateItem().second = std::string(32U, static_cast<char>('a' + i));
+	}
+
+	pool.DestroyItem(0U);
+
+	ASSERT_EQ(pool.GetItemsCount(), 2U);
+	EXPECT_EQ(*pool[0U], std::string(32U, 'c'));
+	EXPECT_EQ(*pool[1U], std::string(32U, 'b'));
+}
+
+// Chunks must be allocated from policy memory resource, and returned to it when pool is destroyed
+TEST_F(MemoryPoolTest, MemoryResourceTest)
+{
+	std::array<std::byte, 16U * 1024U> buffer;
+	std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+	ecs::AllocationPolicy policy;
+	policy.resource = &arena;
+
+	{
+		auto pool = ecs::detail::MemoryPool<TestObject>(k_defaultChunkSize, policy);
+		for (std::size_t i = 0U; i < k_defaultChunkSize + 1U; ++i)
+		{
+			pool.CreateItem();
+		}
+
+		const std::byte* chunkStart = reinterpret_cast<const std::byte*>(pool[0U]);
+		EXPECT_GE(chunkStart, buffer.data());
+		EXPECT_LT(chunkStart, buffer.data() + buffer.size());
+		EXPECT_EQ(pool.GetAllocatedCount(), k_defaultChunkSize * 2U);
+	}
+}
+
+// Chunks past the last alive item must be freed, keeping alive items
+TEST_F(MemoryPoolTest, ReleaseUnusedChunksTest)
+{
+	auto pool = ecs::detail::MemoryPool<TestObject>(k_defaultChunkSize);
+	for (std::size_t i = 0U; i < k_defaultChunkSize * 3U; ++i)
+	{
+		pool.CreateItem().second->a = static_cast<int>(i);
+	}
+
+	pool.DestroyItems(k_defaultChunkSize, k_defaultChunkSize * 2U - 1U);
+
+	EXPECT_EQ(pool.ReleaseUnusedChunks(), 1U);
+	EXPECT_EQ(pool.GetAllocatedCount(), k_defaultChunkSize * 2U);
+	EXPECT_EQ(pool[k_defaultChunkSize]->a, static_cast<int>(k_defaultChunkSize) * 3 - 1);
+}
+
 } // namespace
@@ -0,0 +1,283 @@
+#include <ecs/storage/ObjectPool.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace test
+{
+
+struct PoolTestObject
+{
+	int value = 0;
+
+	PoolTestObject() = default;
+	PoolTestObject(int inValue)
+		: value(inValue)
+	{}
+};
+
+// Object, which counts its constructions and destructions
+struct LifetimeTrackingObject
+{
+	static int constructedCount;
+	static int destroyedCount;
+	static int assignedCount;
+
+	LifetimeTrackingObject(int inValue)
+		: value(inValue)
+	{
+		++constructedCount;
+	}
+
+	LifetimeTrackingObject(const LifetimeTrackingObject& other)
+		: value(other.value)
+	{
+		++constructedCount;
+	}
+
+	LifetimeTrackingObject& operator=(const LifetimeTrackingObject& other)
+	{
+		value = other.value;
+		++assignedCount;
+		return *this;
+	}
+
+	~LifetimeTrackingObject()
+	{
+		++destroyedCount;
+	}
+
+	int value;
+};
+
+struct alignas(64) AlignedPoolTestObject
+{
+	float values[4];
+};
+
+int LifetimeTrackingObject::constructedCount = 0;
+int LifetimeTrackingObject::destroyedCount = 0;
+int LifetimeTrackingObject::assignedCount = 0;
+
+const std::size_t k_testRoomSize = 32U;
+
+class ObjectPoolTest
+	: public ::testing::Test
+{
+protected:
+	using PoolType = ecs::ObjectPool<PoolTestObject, k_testRoomSize>;
+
+	int CountIteratedItems(PoolType& pool)
+	{
+		int iteratedCount = 0;
+		for (auto it = pool.begin(); it != pool.end(); ++it)
+		{
+			++iteratedCount;
+		}
+
+		return iteratedCount;
+	}
+};
+
+// Inserted items must be placed contiguously, starting from the beginning of the pool
+TEST_F(ObjectPoolTest, SequentialInsertionIndexTest)
+{
+	PoolType pool;
+
+	for (int i = 0; i < static_cast<int>(k_testRoomSize) * 2; ++i)
+	{
+		auto result = pool.Emplace(i);
+		EXPECT_EQ(result.index, static_cast<std::size_t>(i));
+		EXPECT_EQ(result.ref.value, i);
+	}
+}
+
+// Removed slot must be reused by the next insertion
+TEST_F(ObjectPoolTest, FreeSlotReuseTest)
+{
+	PoolType pool;
+
+	for (int i = 0; i < 10; ++i)
+	{
+		pool.Emplace(i);
+	}
+
+	pool.RemoveAt(3U);
+	pool.RemoveAt(7U);
+
+	EXPECT_EQ(pool.Emplace(100).index, 3U);
+	EXPECT_EQ(pool.Emplace(101).index, 7U);
+	EXPECT_EQ(pool.Emplace(102).index, 10U);
+}
+
+// Iteration must visit every alive item in index order, skipping empty rooms
+TEST_F(ObjectPoolTest, SparseIterationTest)
+{
+	PoolType pool;
+	const int k_itemsCount = static_cast<int>(k_testRoomSize) * 8;
+
+	for (int i = 0; i < k_itemsCount; ++i)
+	{
+		pool.Emplace(i);
+	}
+
+	// Keep only each 37th item, which leaves some rooms completely empty
+	for (int i = 0; i < k_itemsCount; ++i)
+	{
+		if (i % 37 != 0)
+		{
+			pool.RemoveAt(static_cast<std::size_t>(i));
+		}
+	}
+
+	int expectedValue = 0;
+	for (auto it = pool.begin(); it != pool.end(); ++it)
+	{
+		EXPECT_EQ(it->value, expectedValue);
+		expectedValue += 37;
+	}
+
+	EXPECT_EQ(expectedValue, 37 * ((k_itemsCount + 36) / 37));
+}
+
+// Items placed before the start position of the previous room must not be skipped
+TEST_F(ObjectPoolTest, NextObjectAcrossRoomsTest)
+{
+	PoolType pool;
+
+	for (int i = 0; i < static_cast<int>(k_testRoomSize) * 2; ++i)
+	{
+		pool.Emplace(i);
+	}
+
+	for (std::size_t i = 5U; i < k_testRoomSize * 2U; ++i)
+	{
+		if (i != 5U && i != k_testRoomSize + 1U)
+		{
+			pool.RemoveAt(i);
+		}
+	}
+
+	EXPECT_EQ(pool.GetNextObjectIndex(6U), k_testRoomSize + 1U);
+	EXPECT_EQ(pool.GetNextObjectIndex(k_testRoomSize + 2U), pool.GetInvalidPoolId());
+}
+
+TEST_F(ObjectPoolTest, EmptyPoolIterationTest)
+{
+	PoolType pool;
+	EXPECT_EQ(CountIteratedItems(pool), 0);
+
+	pool.Emplace(1);
+	pool.RemoveAt(0U);
+
+	EXPECT_EQ(CountIteratedItems(pool), 0);
+}
+
+// Growing the rooms directory must not move already inserted items
+TEST_F(ObjectPoolTest, ItemAddressStabilityTest)
+{
+	PoolType pool;
+	PoolTestObject* firstItem = &pool.Emplace(1).ref;
+
+	for (int i = 0; i < static_cast<int>(k_testRoomSize) * 64; ++i)
+	{
+		pool.Emplace(i);
+	}
+
+	EXPECT_EQ(firstItem, &pool.At(0U));
+	EXPECT_EQ(firstItem->value, 1);
+}
+
+// Room creation must not construct items, and items are constructed in place and destroyed on removal
+TEST_F(ObjectPoolTest, InPlaceConstructionTest)
+{
+	LifetimeTrackingObject::constructedCount = 0;
+	LifetimeTrackingObject::destroyedCount = 0;
+	LifetimeTrackingObject::assignedCount = 0;
+
+	{
+		ecs::ObjectPool<LifetimeTrackingObject, k_testRoomSize> pool;
+		pool.Emplace(1);
+		pool.Emplace(2);
+
+		EXPECT_EQ(LifetimeTrackingObject::constructedCount, 2);
+		EXPECT_EQ(LifetimeTrackingObject::assignedCount, 0);
+
+		pool.RemoveAt(0U);
+		EXPECT_EQ(LifetimeTrackingObject::destroyedCount, 1);
+	}
+
+	// Pool destruction destroys only alive items
+	EXPECT_EQ(LifetimeTrackingObject::destroyedCount, 2);
+	EXPECT_EQ(LifetimeTrackingObject::assignedCount, 0);
+}
+
+// Items of over-aligned types must keep their alignment in every room
+TEST_F(ObjectPoolTest, ItemAlignmentTest)
+{
+	ecs::AllocationPolicy policy;
+	policy.alignment = 16U;
+
+	ecs::ObjectPool<AlignedPoolTestObject, k_testRoomSize> pool(policy);
+	for (std::size_t i = 0U; i < k_testRoomSize * 3U; ++i)
+	{
+		AlignedPoolTestObject& item = pool.Emplace().ref;
+		EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&item) % alignof(AlignedPoolTestObject), 0U);
+	}
+}
+
+// Batch insertion must fill reserved rooms contiguously
+TEST_F(ObjectPoolTest, BatchInsertionTest)
+{
+	PoolType pool;
+	pool.Emplace(1);
+	pool.Emplace(2);
+	pool.RemoveAt(0U);
+
+	const std::size_t insertedCount = k_testRoomSize * 2U;
+	pool.Reserve(insertedCount);
+
+	std::vector<std::size_t> indexes;
+	pool.EmplaceMany(insertedCount, [&indexes](const PoolType::InsertResult& insertResult)
+	{
+		indexes.push_back(insertResult.index);
+	}, 7);
+
+	ASSERT_EQ(indexes.size(), insertedCount);
+	EXPECT_EQ(indexes.front(), 0U);
+	EXPECT_EQ(indexes[1], 2U);
+	EXPECT_EQ(indexes.back(), insertedCount);
+	EXPECT_EQ(pool.GetItemsCount(), insertedCount + 1U);
+	EXPECT_EQ(pool.At(indexes.back()).value, 7);
+}
+
+// Releasing empty rooms must keep alive items in place, and released rooms must be recreated on insertion
+TEST_F(ObjectPoolTest, ReleaseEmptyRoomsTest)
+{
+	PoolType pool;
+	for (int i = 0; i < static_cast<int>(k_testRoomSize) * 4; ++i)
+	{
+		pool.Emplace(i);
+	}
+
+	// Empty the second and the last two rooms, keeping a single item in the third one
+	for (std::size_t i = k_testRoomSize; i < k_testRoomSize * 4U; ++i)
+	{
+		if (i != k_testRoomSize * 2U)
+		{
+			pool.RemoveAt(i);
+		}
+	}
+
+	const PoolTestObject* keptItem = &pool.At(k_testRoomSize * 2U);
+	EXPECT_EQ(pool.ReleaseEmptyRooms(), 2U);
+
+	EXPECT_EQ(&pool.At(k_testRoomSize * 2U), keptItem);
+	EXPECT_EQ(keptItem->value, static_cast<int>(k_testRoomSize) * 2);
+	EXPECT_EQ(CountIteratedItems(pool), static_cast<int>(k_testRoomSize) + 1);
+
+	EXPECT_EQ(pool.Emplace(-1).index, k_testRoomSize);
+	EXPECT_EQ(pool.At(k_testRoomSize).value, -1);
+	EXPECT_EQ(CountIteratedItems(pool), static_cast<int>(k_testRoomSize) + 2);
+}
+
+} // namespace
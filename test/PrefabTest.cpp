@@ -0,0 +1,312 @@
+#include <ecs/Manager.hpp>
+#include <gtest/gtest.h>
+
+#include <set>
+#include <vector>
+
+namespace test
+{
+
+struct PrefabPosition
+{
+	int x;
+	int y;
+};
+
+struct PrefabHealth
+{
+	int value;
+};
+
+struct PrefabTag {};
+
+// Counts broadcasts of the manager delegates
+struct PrefabDelegatesListener
+{
+	void OnEntitiesInstantiated(const ecs::Entity* entities, std::size_t count)
+	{
+		++instantiateBroadcastsCount;
+		for (std::size_t i = 0U; i < count; ++i)
+		{
+			instantiatedIds.push_back(entities[i].GetId());
+		}
+	}
+
+	void OnEntityCreated(ecs::Entity)
+	{
+		++createBroadcastsCount;
+	}
+
+	void OnComponentAttached(ecs::Entity&, ecs::ComponentPtr)
+	{
+		++attachBroadcastsCount;
+	}
+
+	std::vector<ecs::EntityId> instantiatedIds;
+	int instantiateBroadcastsCount = 0;
+	int createBroadcastsCount = 0;
+	int attachBroadcastsCount = 0;
+};
+
+class PrefabTest
+	: public ::testing::Test
+{
+protected:
+	PrefabTest()
+	{
+		ecs::Manager::InitECSManager();
+		manager = ecs::Manager::Get();
+
+		manager->RegisterComponentType<PrefabPosition>("PrefabPosition");
+		manager->RegisterComponentType<PrefabHealth>("PrefabHealth");
+		manager->RegisterTagType<PrefabTag>("PrefabTag");
+		manager->Init();
+	}
+
+	~PrefabTest() override
+	{
+		ecs::Manager::ShutdownECSManager();
+	}
+
+	// Root with position and tag, its first child with health and a grand child, its second child without components
+	ecs::Entity CreateSource()
+	{
+		ecs::Entity root = manager->CreateEntity();
+		root.SetName("Root");
+		root.AddComponent(manager->CreateComponent<PrefabPosition>(1, 2));
+		root.AddTag<PrefabTag>();
+
+		ecs::Entity first = manager->CreateEntity();
+		first.SetName("First");
+		first.AddComponent(manager->CreateComponent<PrefabPosition>(3, 4));
+		first.AddComponent(manager->CreateComponent<PrefabHealth>(10));
+		root.AddChild(first);
+
+		ecs::Entity grandChild = manager->CreateEntity();
+		grandChild.SetName("GrandChild");
+		grandChild.AddComponent(manager->CreateComponent<PrefabHealth>(20));
+		first.AddChild(grandChild);
+
+		ecs::Entity second = manager->CreateEntity();
+		root.AddChild(second);
+
+		return root;
+	}
+
+	// Compares instance subtree against the source subtree
+	void ExpectSameSubtree(const ecs::Entity& source, const ecs::Entity& instance)
+	{
+		ASSERT_TRUE(instance.IsValid());
+		EXPECT_NE(instance, source);
+		EXPECT_EQ(instance.GetName(), source.GetName());
+		EXPECT_EQ(instance.HasComponent<PrefabPosition>(), source.HasComponent<PrefabPosition>());
+		EXPECT_EQ(instance.HasComponent<PrefabHealth>(), source.HasComponent<PrefabHealth>());
+		EXPECT_EQ(instance.HasComponent<PrefabTag>(), source.HasComponent<PrefabTag>());
+		EXPECT_EQ(instance.GetComponents().size(), source.GetComponents().size());
+
+		if (source.HasComponent<PrefabPosition>())
+		{
+			EXPECT_EQ(instance.GetComponent<PrefabPosition>()->x, source.GetComponent<PrefabPosition>()->x);
+			EXPECT_EQ(instance.GetComponent<PrefabPosition>()->y, source.GetComponent<PrefabPosition>()->y);
+			EXPECT_EQ(instance.GetComponent<PrefabPosition>().GetEntity(), instance);
+		}
+		if (source.HasComponent<PrefabHealth>())
+		{
+			EXPECT_EQ(instance.GetComponent<PrefabHealth>()->value, source.GetComponent<PrefabHealth>()->value);
+			EXPECT_EQ(instance.GetComponent<PrefabHealth>().GetEntity(), instance);
+		}
+
+		ASSERT_EQ(instance.GetChildrenCount(), source.GetChildrenCount());
+		for (std::size_t i = 0U; i < source.GetChildrenCount(); ++i)
+		{
+			EXPECT_EQ(instance.GetChildByIdx(i).GetParent(), instance);
+			EXPECT_EQ(instance.GetChildByIdx(i).GetDepth(), instance.GetDepth() + 1U);
+			ExpectSameSubtree(source.GetChildByIdx(i), instance.GetChildByIdx(i));
+		}
+	}
+
+	template <class ...ComponentT>
+	std::size_t CountTuples(const uint32_t tupleId)
+	{
+		std::size_t count = 0U;
+		for (const auto& tuple : manager->GetComponentsTupleById<ComponentT...>(tupleId))
+		{
+			(void)tuple;
+			++count;
+		}
+
+		return count;
+	}
+
+	ecs::Manager* manager = nullptr;
+	PrefabDelegatesListener listener; // Outlives manager, which keeps delegates bound to it
+};
+
+TEST_F(PrefabTest, EmptyPrefab)
+{
+	const ecs::Prefab prefab;
+	EXPECT_FALSE(prefab.IsValid());
+
+	ecs::Entity instance;
+	manager->Instantiate(prefab, 1U, &instance);
+	EXPECT_FALSE(instance.IsValid());
+}
+
+TEST_F(PrefabTest, RecordNodes)
+{
+	ecs::Entity source = CreateSource();
+	const ecs::Prefab prefab(source);
+	ASSERT_TRUE(prefab.IsValid());
+
+	// Nodes are in depth first order, parents precede their children
+	const auto& nodes = prefab.GetNodes();
+	ASSERT_EQ(nodes.size(), 4U);
+	EXPECT_EQ(nodes[0].name, "Root");
+	EXPECT_EQ(nodes[0].parentIndex, ecs::Prefab::k_invalidNodeIndex);
+	EXPECT_EQ(nodes[1].name, "First");
+	EXPECT_EQ(nodes[1].parentIndex, 0U);
+	EXPECT_EQ(nodes[2].name, "GrandChild");
+	EXPECT_EQ(nodes[2].parentIndex, 1U);
+	EXPECT_EQ(nodes[3].parentIndex, 0U);
+	EXPECT_EQ(nodes[3].componentsCount, 0U);
+	EXPECT_EQ(prefab.GetComponents().size(), 4U);
+}
+
+TEST_F(PrefabTest, InstancesMatchSource)
+{
+	ecs::Entity source = CreateSource();
+	const ecs::Prefab prefab(source);
+
+	std::vector<ecs::Entity> instances(3U);
+	manager->Instantiate(prefab, instances.size(), instances.data());
+
+	for (const ecs::Entity& instance : instances)
+	{
+		EXPECT_FALSE(instance.GetParent());
+		EXPECT_EQ(instance.GetDepth(), 0U);
+		ExpectSameSubtree(source, instance);
+	}
+	EXPECT_NE(instances[0].GetChildByIdx(0U), instances[1].GetChildByIdx(0U));
+}
+
+TEST_F(PrefabTest, ComponentsAreCopied)
+{
+	ecs::Entity source = CreateSource();
+	const ecs::Prefab prefab(source);
+
+	// Source changes after recording don't reach instances
+	source.GetComponent<PrefabPosition>()->x = 100;
+
+	std::vector<ecs::Entity> instances(2U);
+	manager->Instantiate(prefab, instances.size(), instances.data());
+	EXPECT_EQ(instances[0].GetComponent<PrefabPosition>()->x, 1);
+	EXPECT_NE(instances[0].GetComponent<PrefabPosition>().Get(), source.GetComponent<PrefabPosition>().Get());
+	EXPECT_NE(instances[0].GetComponent<PrefabPosition>().Get(), instances[1].GetComponent<PrefabPosition>().Get());
+
+	// Instance components aren't aliased with other instances, source, or prefab
+	instances[0].GetComponent<PrefabPosition>()->y = 50;
+	instances[0].GetChildByIdx(0U).GetComponent<PrefabHealth>()->value = 70;
+	EXPECT_EQ(instances[1].GetComponent<PrefabPosition>()->y, 2);
+	EXPECT_EQ(instances[1].GetChildByIdx(0U).GetComponent<PrefabHealth>()->value, 10);
+	EXPECT_EQ(source.GetComponent<PrefabPosition>()->y, 2);
+	EXPECT_EQ(source.GetChildByIdx(0U).GetComponent<PrefabHealth>()->value, 10);
+
+	ecs::Entity nextInstance;
+	manager->Instantiate(prefab, 1U, &nextInstance);
+	EXPECT_EQ(nextInstance.GetComponent<PrefabPosition>()->y, 2);
+	EXPECT_EQ(nextInstance.GetChildByIdx(0U).GetComponent<PrefabHealth>()->value, 10);
+}
+
+TEST_F(PrefabTest, TupleCachesContainInstances)
+{
+	const uint32_t positionTupleId = manager->RegisterComponentsTupleIterator<PrefabPosition>();
+	const uint32_t healthTupleId = manager->RegisterComponentsTupleIterator<PrefabHealth>();
+	const uint32_t taggedTupleId = manager->RegisterComponentsTupleIterator<PrefabPosition, PrefabTag>();
+	const uint32_t pairTupleId = manager->RegisterComponentsTupleIterator<PrefabPosition, PrefabHealth>();
+
+	ecs::Entity source = CreateSource();
+	const ecs::Prefab prefab(source);
+	const std::size_t instancesCount = 5U;
+
+	std::vector<ecs::Entity> instances(instancesCount);
+	manager->Instantiate(prefab, instances.size(), instances.data());
+
+	// Every cache has the source entities and all their copies
+	EXPECT_EQ(CountTuples<PrefabPosition>(positionTupleId), 2U * (instancesCount + 1U));
+	EXPECT_EQ(CountTuples<PrefabHealth>(healthTupleId), 2U * (instancesCount + 1U));
+	EXPECT_EQ((CountTuples<PrefabPosition, PrefabTag>(taggedTupleId)), instancesCount + 1U);
+	EXPECT_EQ((CountTuples<PrefabPosition, PrefabHealth>(pairTupleId)), instancesCount + 1U);
+
+	std::set<ecs::EntityId> taggedIds;
+	for (const auto& tuple : manager->GetComponentsTupleById<PrefabPosition, PrefabTag>(taggedTupleId))
+	{
+		EXPECT_EQ(std::get<0>(tuple)->x, 1);
+		taggedIds.insert(std::get<0>(tuple).GetEntity().GetId());
+	}
+	for (const ecs::Entity& instance : instances)
+	{
+		EXPECT_EQ(taggedIds.count(instance.GetId()), 1U);
+	}
+}
+
+TEST_F(PrefabTest, InstantiateDelegateFiresOnce)
+{
+	ecs::Entity source = CreateSource();
+	const ecs::Prefab prefab(source);
+
+	manager->GetEntitiesInstantiateDelegate().BindMemberFunction(&PrefabDelegatesListener::OnEntitiesInstantiated, &listener);
+	manager->GetEntityCreateDelegate().BindMemberFunction(&PrefabDelegatesListener::OnEntityCreated, &listener);
+	manager->GetComponentAttachedDelegate().BindMemberFunction(&PrefabDelegatesListener::OnComponentAttached, &listener);
+
+	std::vector<ecs::Entity> instances(3U);
+	manager->Instantiate(prefab, instances.size(), instances.data());
+
+	// Delegate receives all created entities once, other delegates aren't invoked for the copies
+	EXPECT_EQ(listener.instantiateBroadcastsCount, 1);
+	EXPECT_EQ(listener.createBroadcastsCount, 0);
+	EXPECT_EQ(listener.attachBroadcastsCount, 0);
+	ASSERT_EQ(listener.instantiatedIds.size(), prefab.GetNodes().size() * instances.size());
+
+	std::set<ecs::EntityId> expectedIds;
+	for (const ecs::Entity& instance : instances)
+	{
+		manager->ForEachInHierarchy(instance, [&expectedIds](ecs::Entity& entity)
+		{
+			expectedIds.insert(entity.GetId());
+		});
+	}
+	EXPECT_EQ(std::set<ecs::EntityId>(listener.instantiatedIds.begin(), listener.instantiatedIds.end()), expectedIds);
+}
+
+TEST_F(PrefabTest, InstancesDestroyedWithRoot)
+{
+	const uint32_t healthTupleId = manager->RegisterComponentsTupleIterator<PrefabHealth>();
+
+	ecs::Entity source = CreateSource();
+	const ecs::Prefab prefab(source);
+	manager->GetEntitiesInstantiateDelegate().BindMemberFunction(&PrefabDelegatesListener::OnEntitiesInstantiated, &listener);
+
+	std::vector<ecs::Entity> instances(4U);
+	manager->Instantiate(prefab, instances.size(), instances.data());
+	for (const ecs::EntityId id : listener.instantiatedIds)
+	{
+		ASSERT_TRUE(manager->GetEntityById(id));
+	}
+
+	// Roots hold the only references of non root copies
+	for (ecs::Entity& instance : instances)
+	{
+		instance.Reset();
+	}
+	for (const ecs::EntityId id : listener.instantiatedIds)
+	{
+		EXPECT_FALSE(manager->GetEntityById(id));
+	}
+	EXPECT_EQ(CountTuples<PrefabHealth>(healthTupleId), 2U);
+
+	// Source subtree is untouched
+	ASSERT_EQ(source.GetChildrenCount(), 2U);
+	EXPECT_EQ(source.GetChildByIdx(0U).GetChildByIdx(0U).GetComponent<PrefabHealth>()->value, 20);
+}
+
+} // namespace test
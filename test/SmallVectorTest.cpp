@@ -0,0 +1,128 @@
+#include <ecs/storage/SmallVector.hpp>
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <string>
+
+namespace test
+{
+
+// Counts allocations, passed to the upstream resource
+class CountingResource
+	: public std::pmr::memory_resource
+{
+public:
+	int allocationsCount = 0;
+	int liveAllocationsCount = 0;
+
+private:
+	void* do_allocate(const std::size_t bytes, const std::size_t alignment) override
+	{
+		++allocationsCount;
+		++liveAllocationsCount;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void* p, const std::size_t bytes, const std::size_t alignment) override
+	{
+		--liveAllocationsCount;
+		std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+	}
+
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+	{
+		return this == &other;
+	}
+};
+
+// Vector must not allocate until inline capacity is exceeded, and must free its buffer
+TEST(SmallVectorTest, InlineCapacityTest)
+{
+	CountingResource resource;
+	{
+		ecs::SmallVector<int, 4> values(&resource);
+		for (int i = 0; i < 4; ++i)
+		{
+			values.push_back(i);
+		}
+
+		EXPECT_TRUE(values.IsInline());
+		EXPECT_EQ(resource.allocationsCount, 0);
+
+		values.push_back(4);
+		EXPECT_FALSE(values.IsInline());
+		EXPECT_EQ(resource.allocationsCount, 1);
+		EXPECT_EQ(values[4], 4);
+
+		values.pop_back();
+		values.shrink_to_fit();
+		EXPECT_TRUE(values.IsInline());
+		EXPECT_EQ(values[3], 3);
+	}
+
+	EXPECT_EQ(resource.liveAllocationsCount, 0);
+}
+
+// Insert and erase must keep items order for types, which aren't trivially relocatable
+TEST(SmallVectorTest, InsertEraseTest)
+{
+	CountingResource resource;
+	{
+		ecs::SmallVector<std::string, 2> values(&resource);
+		values.push_back("b");
+		values.push_back("d");
+		values.insert(values.begin(), "a");
+		values.insert(values.begin() + 2, "c");
+		values.insert(values.end(), "e");
+
+		ASSERT_EQ(values.size(), 5U);
+		for (std::size_t i = 0U; i < values.size(); ++i)
+		{
+			EXPECT_EQ(values[i], std::string(1, char('a' + i)));
+		}
+
+		values.erase(values.begin() + 1);
+		values.erase(values.begin());
+		EXPECT_EQ(values[0], "c");
+		EXPECT_EQ(values.back(), "e");
+		EXPECT_EQ(values.size(), 3U);
+	}
+
+	EXPECT_EQ(resource.liveAllocationsCount, 0);
+}
+
+// Move must take heap buffer over, and relocate inline items (assignment keeps target buffer, like std::vector capacity)
+TEST(SmallVectorTest, MoveTest)
+{
+	CountingResource resource;
+	{
+		ecs::SmallVector<std::string, 2> small(&resource);
+		small.push_back("inline");
+
+		ecs::SmallVector<std::string, 2> large(&resource);
+		for (int i = 0; i < 5; ++i)
+		{
+			large.push_back(std::to_string(i));
+		}
+
+		const int allocationsCount = resource.allocationsCount;
+
+		ecs::SmallVector<std::string, 2> movedSmall(std::move(small));
+		ecs::SmallVector<std::string, 2> movedLarge(&resource);
+		movedLarge = std::move(large);
+
+		EXPECT_EQ(resource.allocationsCount, allocationsCount);
+		EXPECT_TRUE(small.empty());
+		EXPECT_TRUE(large.empty());
+		EXPECT_EQ(movedSmall[0], "inline");
+		EXPECT_EQ(movedLarge.size(), 5U);
+		EXPECT_EQ(movedLarge[4], "4");
+
+		movedLarge = std::move(movedSmall);
+		EXPECT_EQ(movedLarge.size(), 1U);
+		EXPECT_EQ(movedLarge[0], "inline");
+	}
+
+	EXPECT_EQ(resource.liveAllocationsCount, 0);
+}
+
+} // namespace
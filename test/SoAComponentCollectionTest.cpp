@@ -0,0 +1,103 @@
+#include <ecs/component/SoAComponentCollection.hpp>
+#include <ecs/component/DenseComponentCollection.hpp>
+#include <ecs/component/CollectionAlignment.hpp>
+#include <gtest/gtest.h>
+
+namespace test
+{
+
+struct SoATestPosition
+{
+	float x;
+	float y;
+	int layer;
+};
+
+struct SoATestVelocity
+{
+	float x;
+	float y;
+};
+
+}
+
+ECS_SOA_COMPONENT(test::SoATestPosition, &test::SoATestPosition::x, &test::SoATestPosition::y, &test::SoATestPosition::layer)
+
+namespace test
+{
+
+class SoAComponentCollectionTest
+	: public ::testing::Test
+{
+protected:
+	using PositionCollection = ecs::SoAComponentCollection<SoATestPosition>;
+	using VelocityCollection = ecs::DenseComponentCollection<SoATestVelocity>;
+};
+
+TEST_F(SoAComponentCollectionTest, ColumnsLayoutTest)
+{
+	PositionCollection collection(0);
+	for (int i = 0; i < 8; ++i)
+	{
+		ecs::ComponentPtr handle = collection.Emplace(static_cast<float>(i), static_cast<float>(i * 2), i);
+	}
+
+	auto xColumn = collection.GetColumn(&SoATestPosition::x);
+	auto layerColumn = collection.GetColumn<2>();
+
+	ASSERT_EQ(xColumn.size, 8U);
+	EXPECT_EQ(xColumn[5], 5.f);
+	EXPECT_EQ(layerColumn[7], 7);
+	EXPECT_EQ(collection.Read(3U).y, 6.f);
+}
+
+TEST_F(SoAComponentCollectionTest, WriteAndRemovalTest)
+{
+	PositionCollection collection(0);
+	for (int i = 0; i < 4; ++i)
+	{
+		ecs::ComponentPtr handle = collection.Emplace(static_cast<float>(i), 0.f, i);
+	}
+
+	collection.Write(1U, SoATestPosition{ 10.f, 20.f, 30 });
+	EXPECT_EQ(collection.Read(1U).layer, 30);
+
+	// Last component must be moved into the removed slot
+	collection.Destroy(0U);
+	ASSERT_EQ(collection.GetSize(), 3U);
+	EXPECT_EQ(collection.Read(0U).x, 3.f);
+	EXPECT_EQ(collection.GetControlBlock(0U)->dataIndex, 0);
+}
+
+// Aligned collections must have components of the same entities at the equal slots
+TEST_F(SoAComponentCollectionTest, CollectionsAlignmentTest)
+{
+	PositionCollection positions(0);
+	VelocityCollection velocities(1);
+
+	// Positions for entities 0..9, velocities for odd entities in reverse order
+	for (int i = 0; i < 10; ++i)
+	{
+		ecs::ComponentPtr handle = positions.Emplace(static_cast<float>(i), 0.f, 0);
+		positions.OnComponentEntityChanged(static_cast<std::size_t>(i), i);
+	}
+
+	for (int i = 9, slot = 0; i >= 0; i -= 2, ++slot)
+	{
+		ecs::ComponentPtr handle = velocities.Emplace(static_cast<float>(i), 0.f);
+		velocities.OnComponentEntityChanged(static_cast<std::size_t>(slot), i);
+	}
+
+	const std::size_t alignedCount = ecs::AlignCollections(positions, velocities);
+	ASSERT_EQ(alignedCount, 5U);
+
+	auto positionX = positions.GetColumn(&SoATestPosition::x);
+	for (std::size_t i = 0U; i < alignedCount; ++i)
+	{
+		EXPECT_EQ(positions.GetEntitiesData()[i], velocities.GetEntitiesData()[i]);
+		EXPECT_EQ(positionX[i], velocities.GetComponentsData()[i].x);
+		EXPECT_EQ(positions.FindByEntity(positions.GetEntitiesData()[i]), static_cast<int32_t>(i));
+	}
+}
+
+} // namespace
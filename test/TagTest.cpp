@@ -0,0 +1,150 @@
+#include <ecs/Manager.hpp>
+#include <gtest/gtest.h>
+
+namespace test
+{
+
+struct TaggedPosition
+{
+	int value;
+};
+
+struct EnemyTag {};
+struct FrozenTag {};
+struct SelectedTag {};
+
+class TagTest
+	: public ::testing::Test
+{
+protected:
+	TagTest()
+	{
+		ecs::Manager::InitECSManager();
+		manager = ecs::Manager::Get();
+
+		manager->RegisterComponentType<TaggedPosition>("TaggedPosition");
+		manager->RegisterTagType<EnemyTag>("EnemyTag");
+		manager->RegisterTagType<FrozenTag>("FrozenTag");
+		manager->RegisterComponentType<SelectedTag>("SelectedTag");
+		manager->Init();
+	}
+
+	~TagTest() override
+	{
+		ecs::Manager::ShutdownECSManager();
+	}
+
+	template <class ...ComponentT>
+	std::size_t CountTuples(const uint32_t tupleId)
+	{
+		std::size_t count = 0U;
+		for (const auto& tuple : manager->GetComponentsTupleById<ComponentT...>(tupleId))
+		{
+			(void)tuple;
+			++count;
+		}
+
+		return count;
+	}
+
+	ecs::Manager* manager = nullptr;
+};
+
+TEST_F(TagTest, RegisterTagType)
+{
+	const ecs::ComponentTypeId enemyTypeId = manager->GetComponentTypeId<EnemyTag>();
+	const ecs::ComponentTypeId positionTypeId = manager->GetComponentTypeId<TaggedPosition>();
+
+	ASSERT_NE(enemyTypeId, ecs::Manager::GetInvalidComponentTypeId());
+	EXPECT_TRUE(manager->IsTagType(enemyTypeId));
+	EXPECT_TRUE(manager->GetTagTypesMask().test(enemyTypeId));
+	EXPECT_FALSE(manager->IsTagType(positionTypeId));
+	EXPECT_FALSE(manager->GetTagTypesMask().test(positionTypeId));
+	EXPECT_EQ(manager->GetTagTypesMask().count(), 3U);
+}
+
+// Empty types have no storage, so registering them as components makes them tags
+TEST_F(TagTest, EmptyComponentTypeIsTag)
+{
+	const ecs::ComponentTypeId selectedTypeId = manager->GetComponentTypeId<SelectedTag>();
+	ASSERT_NE(selectedTypeId, ecs::Manager::GetInvalidComponentTypeId());
+	EXPECT_TRUE(manager->IsTagType(selectedTypeId));
+
+	ecs::Entity entity = manager->CreateEntity();
+	entity.AddTag<SelectedTag>();
+	EXPECT_TRUE(entity.HasComponent<SelectedTag>());
+	EXPECT_TRUE(entity.GetComponents().empty());
+}
+
+TEST_F(TagTest, AddRemoveTag)
+{
+	ecs::Entity entity = manager->CreateEntity();
+	EXPECT_FALSE(entity.HasComponent<EnemyTag>());
+
+	entity.AddTag<EnemyTag>();
+	EXPECT_TRUE(entity.HasComponent<EnemyTag>());
+	EXPECT_FALSE(entity.HasComponent<FrozenTag>());
+
+	// Tags don't take component slots
+	EXPECT_TRUE(entity.GetComponents().empty());
+	EXPECT_FALSE(entity.GetComponent(manager->GetComponentTypeId<EnemyTag>()).IsValid());
+
+	entity.RemoveTag<EnemyTag>();
+	EXPECT_FALSE(entity.HasComponent<EnemyTag>());
+}
+
+TEST_F(TagTest, TupleCacheMembership)
+{
+	const uint32_t tupleId = manager->RegisterComponentsTupleIterator<TaggedPosition, EnemyTag>();
+
+	ecs::Entity entity = manager->CreateEntity();
+	entity.AddComponent(manager->CreateComponent<TaggedPosition>(3));
+	EXPECT_EQ((CountTuples<TaggedPosition, EnemyTag>(tupleId)), 0U);
+
+	entity.AddTag<EnemyTag>();
+	ASSERT_EQ((CountTuples<TaggedPosition, EnemyTag>(tupleId)), 1U);
+	for (const auto& tuple : manager->GetComponentsTupleById<TaggedPosition, EnemyTag>(tupleId))
+	{
+		EXPECT_EQ(std::get<0>(tuple)->value, 3);
+		EXPECT_TRUE(std::get<1>(tuple).IsNull());
+	}
+
+	entity.RemoveTag<EnemyTag>();
+	EXPECT_EQ((CountTuples<TaggedPosition, EnemyTag>(tupleId)), 0U);
+}
+
+TEST_F(TagTest, CloneCopiesTags)
+{
+	const uint32_t tupleId = manager->RegisterComponentsTupleIterator<EnemyTag>();
+
+	ecs::Entity entity = manager->CreateEntity();
+	entity.AddTag<EnemyTag>();
+	entity.AddTag<FrozenTag>();
+
+	ecs::Entity clone = entity.Clone();
+	EXPECT_TRUE(clone.HasComponent<EnemyTag>());
+	EXPECT_TRUE(clone.HasComponent<FrozenTag>());
+	EXPECT_EQ(CountTuples<EnemyTag>(tupleId), 2U);
+
+	// Clone owns its tags
+	clone.RemoveTag<FrozenTag>();
+	EXPECT_TRUE(entity.HasComponent<FrozenTag>());
+}
+
+TEST_F(TagTest, DestroyedTagOnlyEntityLeavesCaches)
+{
+	const uint32_t tupleId = manager->RegisterComponentsTupleIterator<EnemyTag>();
+
+	ecs::Entity entity = manager->CreateEntity();
+	entity.AddTag<EnemyTag>();
+	ecs::Entity otherEntity = manager->CreateEntity();
+	otherEntity.AddTag<EnemyTag>();
+	ASSERT_EQ(CountTuples<EnemyTag>(tupleId), 2U);
+
+	entity.Reset();
+	EXPECT_EQ(CountTuples<EnemyTag>(tupleId), 1U);
+	otherEntity.Reset();
+	EXPECT_EQ(CountTuples<EnemyTag>(tupleId), 0U);
+}
+
+} // namespace test
@@ -0,0 +1,36 @@
+#include <ecs/detail/TypeSequence.hpp>
+#include <gtest/gtest.h>
+
+namespace test
+{
+
+struct SequenceFirst {};
+struct SequenceSecond {};
+
+using ecs::detail::TypeFamily;
+using ecs::detail::TypeSequenceIndex;
+
+// Same type must get the same index from the template cache and from the registry, different types get different indexes
+TEST(TypeSequenceTest, StableIndexTest)
+{
+	const uint32_t first = TypeSequenceIndex<TypeFamily::Component, SequenceFirst>();
+	const uint32_t second = TypeSequenceIndex<TypeFamily::Component, SequenceSecond>();
+
+	const uint32_t firstAgain = TypeSequenceIndex<TypeFamily::Component, SequenceFirst>();
+
+	EXPECT_NE(first, second);
+	EXPECT_EQ(firstAgain, first);
+	EXPECT_EQ(ecs::detail::GetTypeSequenceIndex(TypeFamily::Component, typeid(SequenceSecond)), second);
+}
+
+// Families must be indexed independently, so system indexes stay dense
+TEST(TypeSequenceTest, FamiliesTest)
+{
+	const uint32_t component = TypeSequenceIndex<TypeFamily::Component, SequenceFirst>();
+	const uint32_t system = TypeSequenceIndex<TypeFamily::System, SequenceFirst>();
+
+	EXPECT_EQ(ecs::detail::GetTypeSequenceIndex(TypeFamily::System, typeid(SequenceFirst)), system);
+	EXPECT_EQ(ecs::detail::GetTypeSequenceIndex(TypeFamily::Component, typeid(SequenceFirst)), component);
+}
+
+} // namespace